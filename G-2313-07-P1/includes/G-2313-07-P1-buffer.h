@@ -0,0 +1,65 @@
+/**
+* @brief Cabeceras de los buffers de mensaje compartidos
+* @file G-2313-07-P1-buffer.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <stdatomic.h>  /*Contador de referencias*/
+#include "G-2313-07-P1-server.h"
+
+
+/**
+* @brief Mensaje ya formateado, inmutable y compartido por todas las colas que lo envian
+*/
+typedef struct _Buffer {
+	atomic_long refs;  /*!<Numero de referencias vivas*/
+	size_t len;        /*!<Bytes del mensaje*/
+	char datos[];      /*!<Bytes del mensaje tal y como se envian*/
+} Buffer;
+
+
+/**
+* @brief Crea un buffer con una copia del mensaje y una referencia
+*
+* @param datos mensaje que se copia
+* @param len longitud del mensaje
+* @retval Buffer* el buffer creado
+* @retval NULL si no hay memoria
+*/
+Buffer *IRC_Buffer_New(const char *datos, size_t len);
+
+
+/**
+* @brief Pasa a un buffer un mensaje generado por las funciones IRCMsg_ y lo libera
+*
+* @param msg mensaje reservado con malloc, se libera siempre
+* @retval Buffer* el buffer creado
+* @retval NULL si msg es NULL o no hay memoria
+*/
+Buffer *IRC_Buffer_FromMsg(char *msg);
+
+
+/**
+* @brief Añade una referencia al buffer
+*
+* @param buffer buffer compartido
+* @retval Buffer* el mismo buffer
+*/
+Buffer *IRC_Buffer_Ref(Buffer *buffer);
+
+
+/**
+* @brief Quita una referencia al buffer y lo libera con la ultima
+*
+* @param buffer buffer compartido
+*/
+void IRC_Buffer_Unref(Buffer *buffer);
+
+#endif
@@ -0,0 +1,232 @@
+/**
+* @brief Cabeceras de los miembros de cada canal
+* @file G-2313-07-P1-channels.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef CHANNELS_H
+#define CHANNELS_H
+
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+#include "G-2313-07-P1-buffer.h"
+
+
+#define CHANNELS_HUECOS 1024   /*!<Listas de la tabla de canales, potencia de 2*/
+#define CHANNELS_MIEMBROS 8    /*!<Huecos iniciales del array de miembros de un canal*/
+#define CHANNELS_INICIAL 64    /*!<Huecos iniciales del indice de canales por nombre*/
+#define MIEMBRO_OP 1           /*!<El miembro es operador del canal, sale con '@'*/
+#define MIEMBRO_VOZ 2          /*!<El miembro tiene voz en el canal, sale con '+'*/
+
+
+/**
+* @brief Miembro de un canal con la copia de sus modos en el
+*/
+typedef struct _Miembro {
+	Session *sesion;   /*!<Sesion del miembro*/
+	int modos;         /*!<MIEMBRO_OP y MIEMBRO_VOZ segun los tiene en el TAD*/
+} Miembro;
+
+
+/**
+* @brief Canal con el array contiguo de las sesiones que estan en el
+*/
+struct _Channel {
+	char nombre[MAX_CHANNELNAME+1]; /*!<Nombre del canal tal y como lo guarda el TAD*/
+	unsigned long hash;             /*!<Hash del nombre*/
+	Miembro *miembros;              /*!<Miembros con sus modos, sin huecos*/
+	int nmiembros;                  /*!<Miembros que hay en el array*/
+	int capacidad;                  /*!<Huecos reservados en el array*/
+	long modo;                      /*!<Modos del canal copiados del TAD, como IRCMODE_SECRET*/
+	char *topic;                    /*!<Topic copiado del TAD, NULL si no tiene*/
+	long creado;                    /*!<Segundo en el que se creo, segun IRC_Timer_Now*/
+	long cambiado;                  /*!<Segundo en el que se puso el topic*/
+	char autor[MAX_NICKNAME+1];     /*!<Nick de quien puso el topic*/
+	struct _Channel *sig;           /*!<Siguiente canal de la misma lista de la tabla*/
+};
+
+
+/**
+* @brief Añade una sesion a varios canales, creandolos si no existen, y responde la bienvenida de cada uno
+*
+* @param nombres nombres de los canales que el TAD ha aceptado
+* @param modos MIEMBRO_OP y MIEMBRO_VOZ con los que entra en cada uno, queda a -1 en los que no ha podido entrar
+* @param n numero de canales
+* @param sesion sesion que entra, con la respuesta abierta con IRC_Reply_Begin
+*/
+void IRC_Channels_Join(char **nombres, int *modos, int n, Session *sesion);
+
+
+/**
+* @brief Cambia la copia de los modos de un miembro tras un MODE
+*
+* @param nombre nombre del canal
+* @param sesion miembro
+* @param modos MIEMBRO_OP y MIEMBRO_VOZ que tiene ahora
+*/
+void IRC_Channels_SetModes(const char *nombre, Session *sesion, int modos);
+
+
+/**
+* @brief Cambia la copia de los modos del canal tras un MODE
+*
+* @param nombre nombre del canal
+* @param modo modos que tiene ahora en el TAD
+*/
+void IRC_Channels_SetMode(const char *nombre, long modo);
+
+
+/**
+* @brief Cambia la copia del topic del canal tras un TOPIC
+*
+* @param nombre nombre del canal
+* @param topic topic nuevo, NULL o vacio si se quita
+* @param autor nick de quien lo pone
+*/
+void IRC_Channels_SetTopic(const char *nombre, const char *topic, const char *autor);
+
+
+/**
+* @brief Saca una sesion de un canal, borrandolo si se queda vacio
+*
+* @param nombre nombre del canal
+* @param sesion sesion que sale
+*/
+void IRC_Channels_Part(const char *nombre, Session *sesion);
+
+
+/**
+* @brief Copia los nombres de los canales en los que esta una sesion
+*
+* @param sesion sesion
+* @param nombres donde se copian, caben MAX_CHANELS_USER
+* @retval int numero de canales
+*/
+int IRC_Channels_Mine(Session *sesion, char nombres[][MAX_CHANNELNAME+1]);
+
+
+/**
+* @brief Saca una sesion de todos sus canales
+*
+* @param sesion sesion que se desconecta
+* @param aviso QUIT que se envia una vez a cada sesion con la que comparte algun canal, o NULL
+*/
+void IRC_Channels_Quit(Session *sesion, Buffer *aviso);
+
+
+/**
+* @brief Envia un mensaje una sola vez a cada sesion que comparte algun canal con otra
+*
+* @param sesion sesion de la que se avisa, a ella no se le envia
+* @param buffer mensaje ya formateado, quien llama conserva su referencia
+*/
+void IRC_Channels_Neighbours(Session *sesion, Buffer *buffer);
+
+
+/**
+* @brief Envia un mensaje compartido a todos los miembros de un canal
+*
+* @param nombre nombre del canal
+* @param buffer mensaje ya formateado
+* @param excepto sesion a la que no se envia, o NULL
+* @param ausentes FALSE para no enviarlo a los miembros ausentes
+* @retval TRUE si el canal existe
+* @retval FALSE si no existe
+*/
+long IRC_Channels_Send(const char *nombre, Buffer *buffer, Session *excepto, long ausentes);
+
+
+/**
+* @brief Entrega un PRIVMSG o NOTICE con varios destinos, una sola vez a cada sesion
+*
+* @param destinos nombres de canal o nicks
+* @param buffers mensaje ya formateado de cada destino
+* @param n numero de destinos
+* @param sesion quien lo envia, con la respuesta abierta con IRC_Reply_Begin
+* @param avisos FALSE para NOTICE, que no contesta errores ni ausencias
+*/
+void IRC_Channels_Deliver(char **destinos, Buffer **buffers, int n, Session *sesion, long avisos);
+
+
+/**
+* @brief Responde RPL_LIST con un canal
+*
+* @param nombre nombre del canal
+* @param sesion cliente que lo pide, al que van las respuestas
+*/
+void IRC_Channels_List(const char *nombre, Session *sesion);
+
+
+/**
+* @brief Responde RPL_LIST con los canales que cumplen un filtro despues del ultimo revisado
+*
+* @param filtro condiciones de los canales, guarda el nombre del ultimo canal revisado
+* @param sesion cliente que lo pide, al que van las respuestas
+* @param cuota bytes de respuesta y canales revisados tras los que se para
+* @retval TRUE si ha terminado
+* @retval FALSE si quedan canales
+*/
+long IRC_Channels_ListFrom(Filtro *filtro, Session *sesion, size_t cuota);
+
+
+/**
+* @brief Responde RPL_WHOREPLY con los miembros de un canal a partir de una posicion
+*
+* @param filtro canal en la mascara y si solo se quieren sus operadores
+* @param posicion siguiente miembro del canal, se deja en el siguiente al ultimo enviado
+* @param sesion cliente que lo pide, al que van las respuestas
+* @param cuota bytes de respuesta tras los que se para
+* @retval TRUE si ha llegado al final o el canal no existe
+* @retval FALSE si quedan miembros
+*/
+long IRC_Channels_WhoFrom(const Filtro *filtro, long *posicion, Session *sesion, size_t cuota);
+
+
+/**
+* @brief Responde RPL_WHOREPLY con los usuarios que cumplen una mascara despues del ultimo revisado
+*
+* @param filtro mascara y si solo se quieren operadores, guarda el indice que recorre y el ultimo usuario revisado
+* @param sesion cliente que lo pide, al que van las respuestas
+* @param cuota bytes de respuesta y usuarios revisados tras los que se para
+* @retval TRUE si ha terminado
+* @retval FALSE si quedan usuarios
+*/
+long IRC_Channels_WhoMatch(Filtro *filtro, Session *sesion, size_t cuota);
+
+
+/**
+* @brief Responde RPL_NAMREPLY con los miembros de un canal
+*
+* @param nombre nombre del canal
+* @param sesion cliente que lo pide, al que van las respuestas
+*/
+void IRC_Channels_Names(const char *nombre, Session *sesion);
+
+
+/**
+* @brief Responde RPL_NAMREPLY con todos los canales visibles y los usuarios sin canal despues del ultimo revisado
+*
+* @param filtro guarda el indice que recorre y el ultimo canal o usuario revisado
+* @param sesion cliente que lo pide, al que van las respuestas
+* @param cuota bytes de respuesta y canales o usuarios revisados tras los que se para
+* @retval TRUE si ha terminado
+* @retval FALSE si quedan canales o usuarios
+*/
+long IRC_Channels_NamesFrom(Filtro *filtro, Session *sesion, size_t cuota);
+
+
+/**
+* @brief Responde RPL_WHOISCHANNELS con los canales visibles de un usuario
+*
+* Hay que tener el bloqueo de lectura del indice de usuarios.
+*
+* @param objetivo usuario por el que se pregunta
+* @param sesion cliente que lo pide, al que van las respuestas
+*/
+void IRC_Channels_Whois(Session *objetivo, Session *sesion);
+
+#endif
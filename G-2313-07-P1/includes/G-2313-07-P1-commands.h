@@ -0,0 +1,110 @@
+/**
+* @brief Cabeceras de la tabla de comandos del servidor y sus manejadores
+* @file G-2313-07-P1-commands.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <strings.h>    /*strcasecmp*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+
+
+#define MAX_PARAMS 15          /*!<Parametros como maximo de un mensaje IRC*/
+#define COMANDOS_HUECOS 64     /*!<Huecos de la tabla de comandos, potencia de 2*/
+
+
+/**
+* @brief Trozo de una linea recibida
+*
+* Apunta dentro de la propia linea, que se corta con '\0' al final del trozo, asi que
+* texto se puede usar tambien como cadena. Un trozo que no esta tiene texto a NULL.
+*/
+typedef struct _Trozo {
+	char *texto;    /*!<Inicio del trozo dentro de la linea*/
+	size_t len;     /*!<Bytes del trozo*/
+} Trozo;
+
+
+/**
+* @brief Mensaje IRC ya separado en etiquetas, prefijo, verbo y parametros
+*
+* El ultimo parametro es el que empieza por ':' o el que completa MAX_PARAMS, y llega
+* sin los ':'.
+*/
+typedef struct _Mensaje {
+	Trozo tags;                 /*!<Etiquetas IRCv3 sin la '@'*/
+	Trozo prefix;               /*!<Prefijo sin los ':'*/
+	Trozo verbo;                /*!<Comando*/
+	int nparams;                /*!<Numero de parametros*/
+	Trozo params[MAX_PARAMS];   /*!<Parametros*/
+} Mensaje;
+
+
+/**
+* @brief Manejador de un comando
+*
+* Recibe el mensaje ya separado. Devuelve TRUE si hay que cerrar la conexion.
+*/
+typedef long (*Manejador)(Session *sesion, Mensaje *mensaje);
+
+
+/**
+* @brief Entrada de la tabla de comandos
+*/
+typedef struct _Comando {
+	const char *verbo;      /*!<Comando en mayusculas*/
+	Manejador manejador;    /*!<Funcion que lo atiende*/
+	int min;                /*!<Parametros minimos, con menos se responde ERR_NEEDMOREPARAMS*/
+	int max;                /*!<Parametros maximos, los que sobran se ignoran*/
+	int registro;           /*!<TRUE si solo se atiende con la sesion registrada*/
+} Comando;
+
+
+/**
+* @brief Parametro i del mensaje como cadena
+*/
+#define PARAM(mensaje, i) ((i) < (mensaje)->nparams ? (mensaje)->params[i].texto : NULL)
+
+
+/**
+* @brief Busca una semilla con la que el hash de los comandos no tenga colisiones
+*/
+void IRC_Commands_Init();
+
+
+/**
+* @brief Separa una linea en etiquetas, prefijo, verbo y parametros sobre la propia linea
+*
+* @param command linea recibida, se corta con '\0' en cada separador
+* @param mensaje mensaje que se rellena
+* @retval TRUE si la linea tiene verbo
+* @retval FALSE si esta vacia o solo tiene prefijo
+*/
+long IRC_Commands_Split(char *command, Mensaje *mensaje);
+
+
+/**
+* @brief Busca un comando en la tabla
+*
+* @param verbo comando, en mayusculas o minusculas
+* @retval Comando* la entrada del comando
+* @retval NULL si el servidor no lo implementa
+*/
+const Comando *IRC_Commands_Find(const char *verbo);
+
+
+/**
+* @brief Da de alta al usuario si la sesion ya tiene NICK, USER y el host definitivo
+*
+* @param sesion sesion del cliente
+*/
+void IRC_Commands_Register(Session *sesion);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+* @brief Cabeceras de los cursores que generan por partes las respuestas largas
+* @file G-2313-07-P1-cursor.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef CURSOR_H
+#define CURSOR_H
+
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-mask.h"
+
+
+#define CURSOR_NINGUNO 0     /*!<No hay ninguna respuesta a medias*/
+#define CURSOR_LIST 1        /*!<LIST sin canales, recorre el indice de canales por nombre*/
+#define CURSOR_WHO 2         /*!<WHO de un canal, recorre sus miembros*/
+#define CURSOR_USUARIOS 3    /*!<WHO con una mascara, recorre los indices de usuarios*/
+#define CURSOR_NAMES 4       /*!<NAMES sin canales, recorre los canales y despues los nicks*/
+#define CURSOR_CUOTA 16384   /*!<Bytes que genera un cursor cada vez que la cola se vacia*/
+#define FILTRO_NADA -1       /*!<Condicion del filtro que no se ha pedido*/
+#define FILTRO_NINGUNO 0     /*!<Aun no se ha elegido por donde recorrer los canales*/
+#define FILTRO_NOMBRES 1     /*!<Se recorre el indice de canales por nombre*/
+#define FILTRO_USUARIOS 2    /*!<Se recorren los indices de usuarios, ver G-2313-07-P1-users.h*/
+
+
+/**
+* @brief Condiciones que tienen que cumplir los canales de un LIST, o los usuarios de un WHO
+*/
+typedef struct _Filtro {
+	Mascara mascara;   /*!<Nombre de los canales en LIST, canal o mascara de los usuarios en WHO*/
+	int operadores;    /*!<WHO solo de los operadores de canal*/
+	int negada;        /*!<Salen los canales que no cumplen la mascara*/
+	long mas;          /*!<Mas de estos miembros, o FILTRO_NADA*/
+	long menos;        /*!<Menos de estos miembros, o FILTRO_NADA*/
+	long creado_mas;   /*!<Creado hace mas de estos segundos, o FILTRO_NADA*/
+	long creado_menos; /*!<Creado hace menos de estos segundos, o FILTRO_NADA*/
+	long topic_mas;    /*!<Topic puesto hace mas de estos segundos, o FILTRO_NADA*/
+	long topic_menos;  /*!<Topic puesto hace menos de estos segundos, o FILTRO_NADA*/
+	int indice;        /*!<FILTRO_NOMBRES o FILTRO_USUARIOS, lo elige la primera cuota*/
+	int campo;         /*!<Indice de usuarios que se esta recorriendo con FILTRO_USUARIOS*/
+	char ultimo[MAX_HOST]; /*!<Nombre del ultimo canal revisado, o campo del ultimo usuario, la siguiente cuota sigue desde el*/
+	char nick[MAX_NICKNAME+1]; /*!<Nick del ultimo usuario revisado, vacio si aun no se ha revisado ninguno del indice*/
+} Filtro;
+
+
+/**
+* @brief Respuesta larga a medias de una sesion
+*/
+typedef struct _Cursor {
+	int tipo;          /*!<CURSOR_LIST, CURSOR_WHO, CURSOR_USUARIOS, CURSOR_NAMES o CURSOR_NINGUNO*/
+	long posicion;     /*!<Siguiente miembro del canal en el WHO de un canal*/
+	Filtro filtro;     /*!<Canales que se quieren*/
+} Cursor;
+
+
+/**
+* @brief Deja un filtro sin condiciones, con solo la mascara
+*
+* @param filtro filtro que se rellena
+* @param mascara mascara del nombre, NULL para cualquiera
+*/
+void IRC_Cursor_Filter(Filtro *filtro, const char *mascara);
+
+
+/**
+* @brief Empieza una respuesta larga y genera su primera cuota
+*
+* @param sesion cliente que la pide, con la respuesta abierta con IRC_Reply_Begin
+* @param tipo CURSOR_LIST, CURSOR_WHO, CURSOR_USUARIOS o CURSOR_NAMES
+* @param filtro canales del LIST, o canal o usuarios del WHO, sin condiciones en NAMES
+*/
+void IRC_Cursor_Start(Session *sesion, int tipo, const Filtro *filtro);
+
+
+/**
+* @brief Genera la siguiente cuota de la respuesta a medias de una sesion
+*
+* @param sesion cliente
+* @retval TRUE si aun queda respuesta
+* @retval FALSE si ha terminado o no habia ninguna
+*/
+long IRC_Cursor_Step(Session *sesion);
+
+
+/**
+* @brief Indica si la sesion tiene una respuesta a medias
+*
+* @param sesion cliente
+* @retval TRUE si hay un cursor abierto
+* @retval FALSE si no
+*/
+long IRC_Cursor_Active(Session *sesion);
+
+#endif
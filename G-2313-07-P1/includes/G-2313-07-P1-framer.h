@@ -0,0 +1,66 @@
+/**
+* @brief Cabeceras del separador de lineas por conexion
+* @file G-2313-07-P1-framer.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef FRAMER_H
+#define FRAMER_H
+
+#include <sys/socket.h> /*Para recvmsg*/
+#include <sys/uio.h>    /*Para struct iovec*/
+#include "G-2313-07-P1-server.h"
+
+
+#define FRAMER_SIZE 4096 /*!<Tamaño del buffer circular de entrada, potencia de 2*/
+
+
+/**
+* @brief Buffer circular de entrada de una conexion
+*
+* Las posiciones inicio, fin y revisado crecen siempre y se reducen al tamaño del
+* buffer al acceder, asi fin - inicio son los bytes pendientes.
+*/
+typedef struct _Framer {
+	char datos[FRAMER_SIZE];   /*!<Buffer circular con lo recibido*/
+	size_t inicio;             /*!<Primer byte sin consumir*/
+	size_t fin;                /*!<Byte siguiente al ultimo recibido*/
+	size_t revisado;           /*!<Hasta donde se ha buscado ya el fin de linea*/
+	int descartando;           /*!<La linea en curso supera MAX_BUFFER y se tira hasta su fin*/
+	char linea[MAX_BUFFER+1];  /*!<Copia de las lineas que dan la vuelta al buffer*/
+} Framer;
+
+
+/**
+* @brief Deja el buffer de entrada vacio
+*
+* @param framer buffer que se inicializa
+*/
+void IRC_Framer_Init(Framer *framer);
+
+
+/**
+* @brief Recibe del socket todo lo que quepa en el hueco libre del buffer
+*
+* @param framer buffer de la conexion
+* @param desc descriptor del socket
+* @param flags flags de recvmsg, MSG_DONTWAIT en los reactores
+* @retval ssize_t bytes recibidos, 0 si el cliente ha cerrado o -1 en caso de error con errno
+*/
+ssize_t IRC_Framer_Read(Framer *framer, int desc, int flags);
+
+
+/**
+* @brief Devuelve la siguiente linea completa sin CR/LF y terminada en '\0'
+*
+* @param framer buffer de la conexion
+* @retval char* la linea, valida hasta la siguiente llamada a IRC_Framer_Read
+* @retval NULL si no hay ninguna linea completa
+*/
+char *IRC_Framer_Next(Framer *framer);
+
+#endif
@@ -0,0 +1,49 @@
+/**
+* @brief Cabeceras de las mascaras con comodines de LIST y WHO
+* @file G-2313-07-P1-mask.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef MASK_H
+#define MASK_H
+
+#include "G-2313-07-P1-server.h"
+
+
+#define MASK_MAX MAX_HOST   /*!<Tamaño maximo de una mascara, cabe un host entero*/
+
+
+/**
+* @brief Mascara ya preparada para compararla con muchos nombres
+*/
+typedef struct _Mascara {
+	char patron[MASK_MAX+1]; /*!<Mascara con '*' y '?', vacia si vale cualquier nombre*/
+	int prefijo;             /*!<Caracteres fijos antes del primer comodin*/
+	int comodines;           /*!<FALSE si no tiene comodines y basta comparar el nombre entero*/
+} Mascara;
+
+
+/**
+* @brief Prepara una mascara
+*
+* @param mascara mascara que se rellena
+* @param patron texto de la mascara, NULL o vacio para cualquier nombre
+*/
+void IRC_Mask_Compile(Mascara *mascara, const char *patron);
+
+
+/**
+* @brief Compara un nombre con una mascara sin distinguir mayusculas
+*
+* @param mascara mascara preparada con IRC_Mask_Compile
+* @param nombre nombre que se compara
+* @retval TRUE si el nombre cumple la mascara
+* @retval FALSE si no
+*/
+long IRC_Mask_Match(const Mascara *mascara, const char *nombre);
+
+#endif
@@ -0,0 +1,97 @@
+/**
+* @brief Cabeceras de los bucles de eventos basados en epoll
+* @file G-2313-07-P1-reactor.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <sys/epoll.h>   /*epoll*/
+#include <sys/eventfd.h> /*Para despertar a un reactor desde otro hilo*/
+#include <fcntl.h>       /*Para O_NONBLOCK*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+#include "G-2313-07-P1-buffer.h"
+#include "G-2313-07-P1-timer.h"
+
+
+#define MAX_EVENTS 64          /*!<Numero maximo de eventos recogidos en cada epoll_wait*/
+#define MAX_DESCRIPTORS 65536  /*!<Descriptores maximos que se pueden repartir entre reactores*/
+#define MAX_REACTORS 64        /*!<Numero maximo de reactores*/
+
+
+/**
+* @brief Mensaje pendiente de entregar a una conexion de otro reactor
+*/
+typedef struct _Entrega {
+	int desc;              /*!<Descriptor destino*/
+	long id;               /*!<Sesion destino, la entrega se descarta si el descriptor ya es de otra*/
+	Buffer *buffer;        /*!<Referencia al mensaje, NULL si es un aviso del resolvedor*/
+	struct _Entrega *sig;  /*!<Siguiente entrega del buzon*/
+} Entrega;
+
+
+/**
+* @brief Bucle de eventos con su propio socket de escucha, epoll y conexiones
+*/
+typedef struct _Reactor {
+	int id;                     /*!<Numero de reactor*/
+	int sockval;                /*!<Socket de escucha propio, abierto con SO_REUSEPORT*/
+	int epfd;                   /*!<Descriptor de epoll*/
+	int avisos;                 /*!<eventfd con el que otros reactores le despiertan*/
+	pthread_t hilo;             /*!<Hilo que ejecuta el reactor*/
+	pthread_mutex_t mutex;      /*!<Protege el buzon*/
+	Entrega *buzon;             /*!<Primera entrega pendiente*/
+	Entrega *ultima;            /*!<Ultima entrega pendiente*/
+	Session *pendientes;        /*!<Sesiones con algo que enviar o que cerrar en esta vuelta*/
+	Wheel rueda;                /*!<Temporizadores de PING, PONG y registro de sus sesiones*/
+} Reactor;
+
+
+/**
+* @brief Lanza los reactores y atiende clientes con ellos, uno por nucleo por defecto
+*
+* @param sockval valor del socket del servidor, lo usa el primer reactor
+* @param nreactores numero de reactores, si es menor que 1 se usa uno por nucleo
+*/
+void IRC_Reactor_Run(int sockval, int nreactores);
+
+
+/**
+* @brief Envia un mensaje a una sesion, sea cual sea el reactor que la atiende
+*
+* @param sesion sesion destino
+* @param msg mensaje terminado en '\0' que se quiere enviar
+*/
+void IRC_Reactor_Send(Session *sesion, char *msg);
+
+
+/**
+* @brief Envia un mensaje compartido a una sesion sin copiarlo
+*
+* @param sesion sesion destino
+* @param buffer mensaje ya formateado, quien llama conserva su referencia
+*/
+void IRC_Reactor_SendBuffer(Session *sesion, Buffer *buffer);
+
+
+/**
+* @brief Avisa al reactor de una conexion de que ya se ha resuelto su host
+*
+* @param desc descriptor de la conexion
+* @param id identificador de la sesion que pidio la resolucion
+*/
+void IRC_Reactor_Notify(int desc, long id);
+
+
+/**
+* @brief Despierta a todos los reactores, se puede llamar desde un manejador de señal
+*/
+void IRC_Reactor_Wake();
+
+#endif
@@ -0,0 +1,185 @@
+/**
+* @brief Cabeceras del constructor de respuestas del servidor
+* @file G-2313-07-P1-reply.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef REPLY_H
+#define REPLY_H
+
+#include <stdarg.h>     /*Argumentos variables*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+#include "G-2313-07-P1-buffer.h"
+
+
+#define REPLY_ARENA 32768     /*!<Bytes de respuesta que se acumulan antes de encolarlos*/
+
+
+/**
+* @brief Respuestas pendientes del comando en curso, una por hilo
+*/
+typedef struct _Arena {
+	char datos[REPLY_ARENA];  /*!<Lineas ya formateadas con su CR/LF*/
+	size_t len;               /*!<Bytes ocupados*/
+	size_t enviados;          /*!<Bytes ya encolados desde la IRC_Reply_Begin mas externa*/
+	int abiertas;             /*!<Llamadas a IRC_Reply_Begin sin su IRC_Reply_End*/
+	Session *sesion;          /*!<Cliente al que van las respuestas*/
+} Arena;
+
+
+/**
+* @brief Respuesta numerica con una lista de nombres que se reparte en varias lineas
+*
+* Cada linea repite la cabecera, por ejemplo ":servidor 353 nick = #canal :", y lleva
+* tantos nombres como quepan en MAX_BUFFER bytes.
+*/
+typedef struct _Lista {
+	char linea[MAX_BUFFER];   /*!<Linea en construccion, sin CR/LF*/
+	size_t cabecera;          /*!<Bytes de la cabecera que se repite en cada linea*/
+	size_t len;               /*!<Bytes ocupados de la linea*/
+} Lista;
+
+
+/**
+* @brief Empieza a acumular las respuestas de un comando para un cliente
+*
+* @param sesion cliente al que van las respuestas
+*/
+void IRC_Reply_Begin(Session *sesion);
+
+
+/**
+* @brief Encola al cliente todo lo acumulado y deja la arena vacia
+*/
+void IRC_Reply_End();
+
+
+/**
+* @brief Bytes de respuesta generados desde la IRC_Reply_Begin mas externa
+*
+* @retval size_t bytes encolados y pendientes en la arena
+*/
+size_t IRC_Reply_Written();
+
+
+/**
+* @brief Añade una linea al cliente en curso, el CR/LF lo pone la funcion
+*
+* @param formato formato como el de printf
+*/
+void IRC_Reply_Line(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+
+
+/**
+* @brief Añade bytes ya formateados, con sus CR/LF, al cliente en curso
+*
+* @param datos bytes que se copian
+* @param n numero de bytes
+*/
+void IRC_Reply_Bytes(const char *datos, size_t n);
+
+
+/**
+* @brief Añade una respuesta numerica ":servidor nnn nick ..." al cliente en curso
+*
+* @param numerico codigo de la respuesta
+* @param formato formato como el de printf de lo que va despues del nick
+*/
+void IRC_Reply_Numeric(int numerico, const char *formato, ...) __attribute__((format(printf, 2, 3)));
+
+
+/**
+* @brief Formatea una linea en un buffer para enviarla a otros clientes
+*
+* @param formato formato como el de printf, sin CR/LF
+* @retval Buffer* el buffer con una referencia
+* @retval NULL si no hay memoria
+*/
+Buffer *IRC_Reply_Shared(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+
+
+/**
+* @brief Empieza una respuesta numerica con lista de nombres para el cliente en curso
+*
+* @param lista lista que se inicializa
+* @param numerico codigo de la respuesta
+* @param formato formato como el de printf de la cabecera que va despues del nick
+*/
+void IRC_Reply_ListOpen(Lista *lista, int numerico, const char *formato, ...) __attribute__((format(printf, 3, 4)));
+
+
+/**
+* @brief Añade un nombre a la lista, empezando otra linea si no cabe
+*
+* @param lista lista abierta con IRC_Reply_ListOpen
+* @param prefijo lo que va pegado delante del nombre, como "@", o ""
+* @param nombre nombre que se añade
+*/
+void IRC_Reply_ListAdd(Lista *lista, const char *prefijo, const char *nombre);
+
+
+/**
+* @brief Añade al cliente en curso la ultima linea de la lista si tiene algun nombre
+*
+* @param lista lista abierta con IRC_Reply_ListOpen
+*/
+void IRC_Reply_ListClose(Lista *lista);
+
+
+/*Respuestas numericas del RFC 2812 que usa el servidor*/
+#define IRC_Reply_LuserClient(usuarios, invisibles) IRC_Reply_Numeric(251, ":There are %ld users and %ld invisible on 1 servers", usuarios, invisibles)
+#define IRC_Reply_LuserOp(n)                  IRC_Reply_Numeric(252, "%ld :operator(s) online", n)
+#define IRC_Reply_LuserUnknown(n)             IRC_Reply_Numeric(253, "%ld :unknown connection(s)", n)
+#define IRC_Reply_LuserChannels(n)            IRC_Reply_Numeric(254, "%ld :channels formed", n)
+#define IRC_Reply_LuserMe(n)                  IRC_Reply_Numeric(255, ":I have %ld clients and 0 servers", n)
+#define IRC_Reply_LocalUsers(n, maximo)       IRC_Reply_Numeric(265, "%ld %ld :Current local users %ld, max %ld", n, maximo, n, maximo)
+#define IRC_Reply_GlobalUsers(n, maximo)      IRC_Reply_Numeric(266, "%ld %ld :Current global users %ld, max %ld", n, maximo, n, maximo)
+#define IRC_Reply_Away(nick, texto)           IRC_Reply_Numeric(301, "%s :%s", nick, texto)
+#define IRC_Reply_Unaway()                    IRC_Reply_Numeric(305, ":You are no longer marked as being away")
+#define IRC_Reply_NowAway()                   IRC_Reply_Numeric(306, ":You have been marked as being away")
+#define IRC_Reply_WhoisUser(nick, user, host, real) IRC_Reply_Numeric(311, "%s ~%s %s * :%s", nick, user, host, real)
+#define IRC_Reply_WhoisServer(nick)           IRC_Reply_Numeric(312, "%s %s :Servidor IRC de Redes II", nick, SERVER)
+#define IRC_Reply_EndOfWho(mascara)           IRC_Reply_Numeric(315, "%s :End of WHO list", mascara)
+#define IRC_Reply_WhoisIdle(nick, idle, signon) IRC_Reply_Numeric(317, "%s %ld %ld :seconds idle, signon time", nick, idle, signon)
+#define IRC_Reply_EndOfWhois(nick)            IRC_Reply_Numeric(318, "%s :End of WHOIS list", nick)
+#define IRC_Reply_WhoisChannels(lista, nick)  IRC_Reply_ListOpen(lista, 319, "%s :", nick)
+#define IRC_Reply_ListStart()                 IRC_Reply_Numeric(321, "Channel :Users  Name")
+#define IRC_Reply_List(canal, n, topic)       IRC_Reply_Numeric(322, "%s %ld :%s", canal, n, topic)
+#define IRC_Reply_ListEnd()                   IRC_Reply_Numeric(323, ":End of LIST")
+#define IRC_Reply_NoTopic(canal)              IRC_Reply_Numeric(331, "%s :No topic is set", canal)
+#define IRC_Reply_Topic(canal, topic)         IRC_Reply_Numeric(332, "%s :%s", canal, topic)
+#define IRC_Reply_TopicWhoTime(canal, nick, segundo) IRC_Reply_Numeric(333, "%s %s %ld", canal, nick, segundo)
+#define IRC_Reply_WhoReply(canal, user, host, nick, estado, real) \
+	IRC_Reply_Numeric(352, "%s ~%s %s %s %s %s :0 %s", canal, user, host, SERVER, nick, estado, real)
+#define IRC_Reply_NamReply(lista, tipo, canal) IRC_Reply_ListOpen(lista, 353, "%s %s :", tipo, canal)
+#define IRC_Reply_EndOfNames(canal)           IRC_Reply_Numeric(366, "%s :End of NAMES list", canal)
+#define IRC_Reply_Rehashing(fichero)          IRC_Reply_Numeric(382, "%s :Rehashing", fichero)
+#define IRC_Reply_ErrNoSuchNick(nick)         IRC_Reply_Numeric(401, "%s :No such nick/channel", nick)
+#define IRC_Reply_ErrNoSuchChannel(canal)     IRC_Reply_Numeric(403, "%s :No such channel", canal)
+#define IRC_Reply_ErrTooManyChannels(canal)   IRC_Reply_Numeric(405, "%s :You have joined too many channels", canal)
+#define IRC_Reply_ErrTooManyTargets(destino)  IRC_Reply_Numeric(407, "%s :Too many recipients. Message not delivered", destino)
+#define IRC_Reply_ErrNoRecipient(verbo)       IRC_Reply_Numeric(411, ":No recipient given (%s)", verbo)
+#define IRC_Reply_ErrNoTextToSend()           IRC_Reply_Numeric(412, ":No text to send")
+#define IRC_Reply_ErrUnknownCommand(verbo)    IRC_Reply_Numeric(421, "%s :Unknown command", verbo)
+#define IRC_Reply_ErrNoNicknameGiven()        IRC_Reply_Numeric(431, ":No nickname given")
+#define IRC_Reply_ErrErroneusNickname(nick)   IRC_Reply_Numeric(432, "%s :Erroneous nickname", nick)
+#define IRC_Reply_ErrNicknameInUse(nick)      IRC_Reply_Numeric(433, "%s :Nickname is already in use", nick)
+#define IRC_Reply_ErrUserNotInChannel(nick, canal) IRC_Reply_Numeric(441, "%s %s :They aren't on that channel", nick, canal)
+#define IRC_Reply_ErrNotOnChannel(canal)      IRC_Reply_Numeric(442, "%s :You're not on that channel", canal)
+#define IRC_Reply_ErrNoLogin(user)            IRC_Reply_Numeric(444, "%s :User not logged in", user)
+#define IRC_Reply_ErrNotRegistered()          IRC_Reply_Numeric(451, ":You have not registered")
+#define IRC_Reply_ErrNeedMoreParams(verbo)    IRC_Reply_Numeric(461, "%s :Not enough parameters", verbo)
+#define IRC_Reply_ErrAlreadyRegistred()       IRC_Reply_Numeric(462, ":Unauthorized command (already registered)")
+#define IRC_Reply_ErrChannelIsFull(canal)     IRC_Reply_Numeric(471, "%s :Cannot join channel (+l)", canal)
+#define IRC_Reply_ErrInviteOnlyChan(canal)    IRC_Reply_Numeric(473, "%s :Cannot join channel (+i)", canal)
+#define IRC_Reply_ErrBannedFromChan(canal)    IRC_Reply_Numeric(474, "%s :Cannot join channel (+b)", canal)
+#define IRC_Reply_ErrBadChannelKey(canal)     IRC_Reply_Numeric(475, "%s :Cannot join channel (+k)", canal)
+#define IRC_Reply_ErrNoPrivileges()           IRC_Reply_Numeric(481, ":Permission Denied- You're not an IRC operator")
+#define IRC_Reply_ErrChanOPrivsNeeded(canal)  IRC_Reply_Numeric(482, "%s :You're not channel operator", canal)
+
+#endif
@@ -0,0 +1,88 @@
+/**
+* @brief Cabeceras de la resolucion inversa de nombres de los clientes
+* @file G-2313-07-P1-resolver.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include <arpa/inet.h>  /*inet_ntop*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+
+
+#define RESOLVER_HILOS 4          /*!<Hilos que hacen las consultas DNS*/
+#define RESOLVER_COLA 256         /*!<Consultas pendientes a partir de las que se registra con la IP*/
+#define RESOLVER_CACHE 4096       /*!<Entradas de la cache de nombres, potencia de 2*/
+#define RESOLVER_TTL 3600         /*!<Segundos que se guarda un nombre resuelto*/
+#define RESOLVER_TTL_FALLO 300    /*!<Segundos que se recuerda que una IP no tiene nombre*/
+#define RESOLVER_PLAZO 5          /*!<Segundos desde la conexion que el registro espera al DNS*/
+
+#define RESOLVER_PENDIENTE 0      /*!<La consulta esta en marcha*/
+#define RESOLVER_OK 1             /*!<La IP tiene nombre*/
+#define RESOLVER_FALLO 2          /*!<La IP no tiene nombre o el DNS ha fallado*/
+
+
+/**
+* @brief Consulta pendiente de un hilo del resolvedor
+*/
+typedef struct _Consulta {
+	struct in_addr ip;        /*!<Direccion que se resuelve*/
+	int desc;                 /*!<Descriptor de la conexion que la espera*/
+	long id;                  /*!<Identificador de la sesion, por si el descriptor se reutiliza*/
+	int estado;               /*!<RESOLVER_PENDIENTE hasta que un hilo la termina, luego RESOLVER_OK o RESOLVER_FALLO*/
+	char host[MAX_HOST];      /*!<Nombre de la direccion si estado es RESOLVER_OK*/
+	struct _Consulta *sig;    /*!<Siguiente consulta de la cola*/
+} Consulta;
+
+
+/**
+* @brief Entrada de la cache de nombres
+*/
+typedef struct _Resuelto {
+	struct in_addr ip;        /*!<Direccion*/
+	int estado;               /*!<RESOLVER_PENDIENTE, RESOLVER_OK o RESOLVER_FALLO*/
+	long expira;              /*!<Segundo a partir del que la entrada no vale*/
+	char host[MAX_HOST];      /*!<Nombre de la direccion si estado es RESOLVER_OK*/
+} Resuelto;
+
+
+/**
+* @brief Lanza los hilos del resolvedor
+*
+* @param nhilos numero de hilos, si es menor que 1 se usan RESOLVER_HILOS
+*/
+void IRC_Resolver_Init(int nhilos);
+
+
+/**
+* @brief Empieza a resolver el nombre de una conexion recien aceptada
+*
+* @param sesion sesion de la conexion, se rellenan su IP y su host provisional
+*/
+void IRC_Resolver_Start(Session *sesion);
+
+
+/**
+* @brief Comprueba si el host de la sesion ya es definitivo
+*
+* @param sesion sesion del cliente
+* @retval TRUE si ya se puede registrar, con el nombre o con la IP
+* @retval FALSE si hay que esperar al DNS
+*/
+long IRC_Resolver_Host(Session *sesion);
+
+
+/**
+* @brief Espera a que el host de la sesion sea definitivo, como mucho hasta RESOLVER_PLAZO
+*
+* @param sesion sesion del cliente
+*/
+void IRC_Resolver_Wait(Session *sesion);
+
+#endif
@@ -0,0 +1,106 @@
+/**
+* @brief Cabeceras de la cola de salida de cada conexion
+* @file G-2313-07-P1-sendq.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef SENDQ_H
+#define SENDQ_H
+
+#include <sys/uio.h>    /*Para writev*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-buffer.h"
+
+
+#define SENDQ_DEFAULT 131072  /*!<Bytes pendientes por conexion a partir de los que se desconecta*/
+#define SENDQ_IOV 64          /*!<Bloques que se envian como maximo en cada writev*/
+#define SENDQ_CACHE 4096      /*!<Bloques libres que guarda cada hilo para reutilizarlos*/
+
+#define SENDQ_VACIA 0         /*!<Se ha enviado todo lo que habia en la cola*/
+#define SENDQ_PENDIENTE 1     /*!<El socket no admite mas, quedan datos en la cola*/
+#define SENDQ_ERROR -1        /*!<Error al enviar, hay que cerrar la conexion*/
+
+
+/**
+* @brief Enlace de la cola a un mensaje pendiente de enviar
+*/
+typedef struct _Bloque {
+	struct _Bloque *sig;  /*!<Siguiente bloque de la cola*/
+	Buffer *buffer;       /*!<Mensaje, compartido con el resto de colas que lo envian*/
+	size_t enviado;       /*!<Bytes del mensaje que ya se han enviado por esta cola*/
+} Bloque;
+
+
+/**
+* @brief Cola de salida acotada de una conexion
+*/
+typedef struct _SendQ {
+	Bloque *primero;      /*!<Primer bloque pendiente*/
+	Bloque *ultimo;       /*!<Ultimo bloque pendiente*/
+	size_t pendientes;    /*!<Bytes pendientes de enviar*/
+} SendQ;
+
+
+/**
+* @brief Fija el limite de bytes pendientes por conexion
+*
+* @param limite bytes a partir de los que se desconecta al cliente
+*/
+void IRC_SendQ_Limit(size_t limite);
+
+
+/**
+* @brief Deja la cola vacia
+*
+* @param cola cola que se inicializa
+*/
+void IRC_SendQ_Init(SendQ *cola);
+
+
+/**
+* @brief Añade un mensaje al final de la cola
+*
+* @param cola cola de la conexion
+* @param msg datos que se quieren enviar
+* @param len longitud de los datos
+* @retval TRUE si se ha encolado
+* @retval FALSE si se supera el limite o no hay memoria, hay que desconectar al cliente
+*/
+long IRC_SendQ_Push(SendQ *cola, const char *msg, size_t len);
+
+
+/**
+* @brief Añade al final de la cola una referencia a un mensaje compartido
+*
+* @param cola cola de la conexion
+* @param buffer mensaje ya formateado, la cola toma su propia referencia
+* @retval TRUE si se ha encolado
+* @retval FALSE si se supera el limite o no hay memoria, hay que desconectar al cliente
+*/
+long IRC_SendQ_PushBuffer(SendQ *cola, Buffer *buffer);
+
+
+/**
+* @brief Envia con writev todo lo que admita el socket
+*
+* @param cola cola de la conexion
+* @param desc descriptor no bloqueante de la conexion
+* @retval SENDQ_VACIA si se ha enviado todo
+* @retval SENDQ_PENDIENTE si quedan datos por enviar
+* @retval SENDQ_ERROR si ha fallado el envio
+*/
+int IRC_SendQ_Flush(SendQ *cola, int desc);
+
+
+/**
+* @brief Libera todo lo que quede en la cola
+*
+* @param cola cola que se vacia
+*/
+void IRC_SendQ_Free(SendQ *cola);
+
+#endif
@@ -22,6 +22,7 @@
 #include <sys/time.h>
 #include <netdb.h>
 #include "G-2313-07-P1-utilities.h"
+#include "G-2313-07-P1-log.h"
 
 
 #define MAX_CONNECTIONS 500                        /*!<Numero maximo de conexiones*/
@@ -30,8 +31,22 @@
 #define MAX_NICKNAME 9                             /*!<Tamaño maximo para el nickname*/
 #define MAX_CHANNELNAME 50                         /*!<Tamaño máximo para el nombre de un canal*/
 #define MAX_CHANELS_USER 10                        /*!<Máximo de canales en los que puede estar un usario*/
+#define MAX_HOST 256                               /*!<Tamaño máximo para el nombre de host de un cliente*/
+#define MAX_USERNAME 32                            /*!<Tamaño máximo para el user de USER, se recorta lo que sobre*/
+#define MAX_REALNAME 128                           /*!<Tamaño máximo para el nombre real, se recorta lo que sobre*/
+#define MAX_PREFIX (MAX_NICKNAME + MAX_USERNAME + MAX_HOST + 4) /*!<Tamaño de ":nick!user@host" con el '\0'*/
 #define SERVER "localhost"                         /*!<Nombre del servidor*/
 #define PREFIX_PERSONAL "localhost_alfonso_monica" /*!<Prefijo predeterminado*/
+#define PING_INTERVALO 30                          /*!<Segundos sin recibir nada tras los que se manda PING*/
+#define PONG_PLAZO 30                              /*!<Segundos que se espera respuesta al PING*/
+#define REGISTRO_PLAZO 60                          /*!<Segundos para completar NICK y USER*/
+#ifndef MAX_TARGETS
+#define MAX_TARGETS 8                              /*!<Destinos como mucho de un PRIVMSG o NOTICE, se cambia con make MAXTARGETS=n*/
+#endif
+
+
+typedef struct _Session Session; /*!<Estado de una conexion, definido en G-2313-07-P1-session.h*/
+typedef struct _Channel Channel; /*!<Miembros de un canal, definido en G-2313-07-P1-channels.h*/
 
 
 /**
@@ -44,15 +59,27 @@ int IRC_Initiate_Server();
 
 
 /**
-* @brief Protocolo PING PONG
+* @brief Abre un socket de escucha con SO_REUSEPORT en el puerto del servidor
 *
-* @param sig valor de la señal asociada
+*
+* @retval int El descriptor del socket que acaba de abrir y preparar para escuchar concexiones.
+*/
+int IRC_Open_Socket();
+
+
+/**
+* @brief Protocolo PING PONG y plazo de registro de una conexion
+*
+* @param sesion sesion del cliente
+* @param ahora segundo actual segun IRC_Timer_Now
+* @retval long segundo en el que hay que volver a llamarla
+* @retval -1 si hay que cerrar la conexion
 */
-void IRC_Ping_Pong (int sig);
+long IRC_Ping_Pong (Session *sesion, long ahora);
 
 
 /**
-* @brief Finalizacion del Servidor liberando recursos
+* @brief Manejador de SIGINT, pide terminar el servidor
 *
 *
 * @param sig valor de la señal asociada
@@ -61,7 +88,13 @@ void IRC_End_Server(int sig);
 
 
 /**
-* @brief Acepta una nueva conexion creando un hilo nuevo
+* @brief Finalizacion del Servidor liberando recursos, si IRC_End_Server lo ha pedido
+*/
+void IRC_Stop_Server();
+
+
+/**
+* @brief Acepta una nueva conexion creando un hilo nuevo (modelo de hilos)
 *
 * @param sockval valor del socket del servidor
 */
@@ -71,7 +104,7 @@ void IRC_Accept_Connection(int sockval);
 /**
 * @brief Recibe mensajes del cliente y comprueba si este se ha ido
 *
-* @param valor puntero void con el valor del descriptor de usuario
+* @param valor puntero void a la sesion del cliente
 */
 void *IRC_New_Client(void* valor);
 
@@ -80,12 +113,20 @@ void *IRC_New_Client(void* valor);
 * @brief Parseador de comandos IRC y ejecuta estos
 *
 *
-* @param[in] command puntero a char con el comando recibido y que se va a parsear y ejecutar
-* @param[in] desc entero descriptor del usuario
-* @param[in,out] nick doble puntero char al nick del ususario
-* @param[in,out] prefix_user doble puntero char al prefix del usuario
+* @param[in,out] command linea recibida, se corta al separarla en sus partes
+* @param[in,out] sesion sesion del cliente que lo ha enviado
+* @retval TRUE si el cliente ha hecho QUIT y hay que cerrar la conexion
+* @retval FALSE si la conexion sigue abierta
+*/
+long IRC_Server_Parser(char* command, Session *sesion);
+
+
+/**
+* @brief Termina el registro que se aplazo a la espera del nombre del cliente
+*
+* @param sesion sesion del cliente, en el estado SESION_ESPERA
 */
-void IRC_Server_Parser(char* command, int desc, char** nick, char** prefix_user);
+void IRC_Server_Resume(Session *sesion);
 
 
 #endif
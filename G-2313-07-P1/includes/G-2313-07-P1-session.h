@@ -0,0 +1,89 @@
+/**
+* @brief Cabeceras del estado asociado a cada conexion de cliente
+* @file G-2313-07-P1-session.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <netinet/in.h> /*struct in_addr*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-framer.h"
+#include "G-2313-07-P1-sendq.h"
+#include "G-2313-07-P1-timer.h"
+#include "G-2313-07-P1-cursor.h"
+
+
+#define SESION_NUEVA 0       /*!<Recien conectada*/
+#define SESION_NICK 1        /*!<Ha hecho NICK pero no USER*/
+#define SESION_USER 2        /*!<Ha hecho USER pero no NICK*/
+#define SESION_ESPERA 3      /*!<Ha hecho NICK y USER, espera al DNS para terminar el registro*/
+#define SESION_REGISTRADA 7  /*!<Registrada, puede usar todos los comandos*/
+#define SESSION_SLAB 64      /*!<Sesiones que se reservan de golpe cuando no quedan libres*/
+
+
+/**
+* @brief Estado de una conexion de cliente
+*
+* Contiene todo lo que el servidor necesita saber de un cliente conectado,
+* tanto en el modelo de hilos como en el bucle de eventos. El nick, el prefijo y la
+* ausencia solo se cambian con las funciones de G-2313-07-P1-users.h, porque otros
+* hilos los leen a traves del indice de usuarios.
+*
+* El estado sigue la maquina de registro: SESION_NUEVA pasa a SESION_NICK o SESION_USER
+* segun el comando que llegue primero, con los dos a SESION_ESPERA y, en cuanto el host
+* esta resuelto, a SESION_REGISTRADA. Cada comando suma su bit, asi el orden no importa.
+*/
+struct _Session {
+	int desc;          /*!<Descriptor del socket del cliente*/
+	long id;           /*!<Identificador unico, distingue sesiones que reutilizan el descriptor*/
+	int estado;        /*!<Paso del registro, de SESION_NUEVA a SESION_REGISTRADA*/
+	char nick[MAX_NICKNAME+1];     /*!<Nick del usuario, vacio hasta que hace NICK*/
+	char user[MAX_USERNAME+1];     /*!<User de USER, vacio hasta entonces*/
+	char realname[MAX_REALNAME+1]; /*!<Nombre real de USER*/
+	char prefix[MAX_PREFIX];       /*!<":nick!user@host" ya compuesto, vacio hasta que se registra*/
+	char *away;        /*!<Mensaje de ausencia, NULL si no esta ausente*/
+	Channel *canales[MAX_CHANELS_USER]; /*!<Canales en los que esta, los gestiona G-2313-07-P1-channels.c*/
+	int puestos[MAX_CHANELS_USER];      /*!<Posicion de la sesion en el array de miembros de cada uno de sus canales*/
+	int ncanales;      /*!<Numero de canales en los que esta*/
+	unsigned long marca; /*!<Ultimo aviso a los vecinos que ha recibido, ver G-2313-07-P1-channels.c*/
+	Timer temporizador; /*!<Siguiente PING, plazo del PONG o del registro, solo lo usan los reactores*/
+	long creada;       /*!<Segundo en el que se acepto la conexion*/
+	long actividad;    /*!<Ultimo segundo en el que se recibio algo*/
+	long ping;         /*!<Segundo en el que se envio el PING sin contestar, 0 si no hay ninguno*/
+	struct in_addr direccion; /*!<IP del cliente*/
+	char ip[INET_ADDRSTRLEN]; /*!<IP del cliente en texto*/
+	char host[MAX_HOST]; /*!<Nombre del cliente, la IP hasta que lo resuelve el DNS*/
+	int resuelto;      /*!<El host ya es definitivo, ver G-2313-07-P1-resolver.c*/
+	Framer entrada;    /*!<Buffer de entrada del que salen las lineas completas*/
+	SendQ salida;      /*!<Cola de salida, solo la usan los reactores*/
+	Cursor cursor;     /*!<LIST o WHO a medias, ver G-2313-07-P1-cursor.c*/
+	int cerrar;        /*!<El reactor debe cerrar la conexion al terminar la vuelta*/
+	int pendiente;     /*!<Esta en la lista de sesiones con algo que enviar*/
+	struct _Session *sig_pendiente; /*!<Siguiente sesion con algo que enviar, o siguiente libre del pool*/
+};
+
+
+/**
+* @brief Crea la sesion asociada a una conexion recien aceptada
+*
+* @param desc descriptor del socket del cliente
+* @retval Session* la sesion creada
+* @retval NULL en caso de error al reservar memoria
+*/
+Session *IRC_Session_New(int desc);
+
+
+/**
+* @brief Cierra la conexion y libera la sesion dando de baja al usuario
+*
+* @param sesion puntero a la sesion que se quiere liberar
+*/
+void IRC_Session_Free(Session *sesion);
+
+#endif
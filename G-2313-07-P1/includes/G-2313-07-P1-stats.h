@@ -0,0 +1,65 @@
+/**
+* @brief Cabeceras de los contadores del servidor para LUSERS
+* @file G-2313-07-P1-stats.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdatomic.h>  /*Contadores de cada hilo*/
+#include "G-2313-07-P1-server.h"
+
+
+#define STATS_USUARIOS 0     /*!<Sesiones registradas*/
+#define STATS_INVISIBLES 1   /*!<Usuarios con el modo +i*/
+#define STATS_OPERADORES 2   /*!<Operadores del servidor*/
+#define STATS_DESCONOCIDAS 3 /*!<Conexiones que aun no se han registrado*/
+#define STATS_CANALES 4      /*!<Canales que existen*/
+#define STATS_CONTADORES 5   /*!<Numero de contadores*/
+
+
+/**
+* @brief Contadores de un hilo, los cambia solo ese hilo y cualquiera los suma
+*/
+typedef struct _Contadores {
+	atomic_long valor[STATS_CONTADORES]; /*!<Lo que ha sumado el hilo a cada contador, puede ser negativo*/
+	atomic_int libre;                    /*!<El hilo que lo usaba ha terminado y otro lo puede coger*/
+	struct _Contadores *sig;             /*!<Siguientes contadores de la lista*/
+} Contadores;
+
+
+/**
+* @brief Prepara la clave con la que se reutilizan los contadores de los hilos que terminan
+*/
+void IRC_Stats_Init();
+
+
+/**
+* @brief Suma a un contador desde el hilo en curso
+*
+* @param contador uno de los STATS_
+* @param n lo que se suma, negativo para restar
+*/
+void IRC_Stats_Add(int contador, long n);
+
+
+/**
+* @brief Valor de un contador sumando los de todos los hilos
+*
+* @param contador uno de los STATS_
+* @retval long el valor
+*/
+long IRC_Stats_Get(int contador);
+
+
+/**
+* @brief Añade las respuestas de LUSERS al cliente en curso
+*/
+void IRC_Stats_Lusers();
+
+#endif
@@ -0,0 +1,98 @@
+/**
+* @brief Cabeceras de la rueda de temporizadores de los reactores
+* @file G-2313-07-P1-timer.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <time.h>     /*clock_gettime*/
+#include "G-2313-07-P1-server.h"
+
+
+#define TIMER_BITS 6                      /*!<Bits del segundo que indexan cada nivel*/
+#define TIMER_HUECOS (1 << TIMER_BITS)    /*!<Huecos de cada nivel de la rueda*/
+#define TIMER_NIVELES 2                   /*!<Niveles de la rueda, de 1 y de 64 segundos*/
+#define TIMER_TICK 1000                   /*!<Milisegundos que avanza cada hueco del primer nivel*/
+
+
+/**
+* @brief Temporizador que se engancha en la rueda, va dentro de lo que temporiza
+*/
+typedef struct _Timer {
+	struct _Timer *sig;  /*!<Siguiente temporizador del hueco*/
+	struct _Timer *ant;  /*!<Anterior temporizador del hueco, NULL si no esta en la rueda*/
+	long vence;          /*!<Segundo en el que vence*/
+	void *dueno;         /*!<Lo que se temporiza, normalmente una sesion*/
+} Timer;
+
+
+/**
+* @brief Rueda jerarquica de temporizadores con resolucion de un segundo
+*/
+typedef struct _Wheel {
+	Timer huecos[TIMER_NIVELES][TIMER_HUECOS]; /*!<Cabeceras de las listas de cada hueco*/
+	Timer vencidos;                            /*!<Cabecera de los temporizadores ya vencidos*/
+	long ahora;                                /*!<Ultimo segundo procesado*/
+} Wheel;
+
+
+/**
+* @brief Segundo actual de un reloj monotono
+*
+* @retval long segundos desde un instante fijo
+*/
+long IRC_Timer_Now();
+
+
+/**
+* @brief Deja la rueda vacia
+*
+* @param rueda rueda que se inicializa
+* @param ahora segundo actual
+*/
+void IRC_Timer_Init(Wheel *rueda, long ahora);
+
+
+/**
+* @brief Programa un temporizador, quitandolo antes si ya estaba en la rueda
+*
+* @param rueda rueda del reactor
+* @param temporizador temporizador que se programa
+* @param vence segundo en el que vence
+*/
+void IRC_Timer_Add(Wheel *rueda, Timer *temporizador, long vence);
+
+
+/**
+* @brief Quita un temporizador de la rueda
+*
+* @param temporizador temporizador que se cancela, puede no estar en la rueda
+*/
+void IRC_Timer_Del(Timer *temporizador);
+
+
+/**
+* @brief Avanza la rueda hasta el segundo dado, pasando a vencidos lo que venza
+*
+* @param rueda rueda del reactor
+* @param ahora segundo actual
+*/
+void IRC_Timer_Advance(Wheel *rueda, long ahora);
+
+
+/**
+* @brief Saca el siguiente temporizador vencido
+*
+* @param rueda rueda del reactor
+* @retval Timer* temporizador vencido, ya fuera de la rueda
+* @retval NULL si no queda ninguno
+*/
+Timer *IRC_Timer_Next(Wheel *rueda);
+
+#endif
@@ -0,0 +1,206 @@
+/**
+* @brief Cabeceras del indice de usuarios conectados por nick y por descriptor
+* @file G-2313-07-P1-users.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef USERS_H
+#define USERS_H
+
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+#include "G-2313-07-P1-reactor.h"
+
+
+#define USERS_INICIAL 1024  /*!<Huecos iniciales de la tabla de nicks, siempre potencia de 2*/
+#define USERS_NICK 0        /*!<Indice de sesiones registradas ordenado por nick*/
+#define USERS_USER 1        /*!<Indice de sesiones registradas ordenado por user*/
+#define USERS_HOST 2        /*!<Indice de sesiones registradas ordenado por host*/
+#define USERS_REAL 3        /*!<Indice de sesiones registradas ordenado por nombre real*/
+#define USERS_INDICES 4     /*!<Numero de indices ordenados*/
+
+
+/**
+* @brief Hueco de la tabla de nicks con direccionamiento abierto
+*/
+typedef struct _Ranura {
+	unsigned long hash;  /*!<Hash del nick ya pasado a minusculas*/
+	Session *sesion;     /*!<Sesion que tiene el nick, NULL si el hueco esta libre*/
+} Ranura;
+
+
+/**
+* @brief Calcula el hash de un nick sin distinguir mayusculas
+*
+* @param nombre nick o nombre de canal
+* @retval unsigned long hash del nombre pasado a minusculas segun el RFC 1459
+*/
+unsigned long IRC_Users_Hash(const char *nombre);
+
+
+/**
+* @brief Compara dos nombres sin distinguir mayusculas segun el RFC 1459
+*
+* @param a primer nombre
+* @param b segundo nombre
+* @retval TRUE si son el mismo nombre
+* @retval FALSE si son distintos
+*/
+long IRC_Users_Equal(const char *a, const char *b);
+
+
+/**
+* @brief Pasa un caracter a minusculas segun el RFC 1459, en el que {}|~ son las minusculas de []\^
+*
+* @param c caracter
+* @retval char el caracter en minusculas
+*/
+char IRC_Users_Fold(char c);
+
+
+/**
+* @brief Compara como strncmp sin distinguir mayusculas segun el RFC 1459
+*
+* @param a primer nombre
+* @param b segundo nombre
+* @param n caracteres que se comparan como mucho
+* @retval int menor, igual o mayor que cero segun a vaya antes, sea igual o vaya despues que b
+*/
+int IRC_Users_Compare(const char *a, const char *b, size_t n);
+
+
+/**
+* @brief Da de alta la sesion en el indice por descriptor
+*
+* @param sesion sesion de la conexion recien aceptada
+*/
+void IRC_Users_Connect(Session *sesion);
+
+
+/**
+* @brief Quita la sesion de los dos indices
+*
+* @param sesion sesion que se va a liberar
+*/
+void IRC_Users_Remove(Session *sesion);
+
+
+/**
+* @brief Asigna o cambia el nick de una sesion
+*
+* @param sesion sesion que cambia de nick
+* @param nick nick nuevo
+* @retval TRUE si se ha asignado
+* @retval FALSE si otra sesion ya lo tiene, es demasiado largo o no hay memoria
+*/
+long IRC_Users_SetNick(Session *sesion, const char *nick);
+
+
+/**
+* @brief Compone el prefijo ":nick!user@host" de una sesion que termina de registrarse
+*
+* @param sesion sesion del usuario, con nick, user y host ya puestos
+*/
+void IRC_Users_SetPrefix(Session *sesion);
+
+
+/**
+* @brief Cambia el mensaje de ausencia de una sesion
+*
+* @param sesion sesion del usuario
+* @param away mensaje de ausencia, NULL si vuelve
+*/
+void IRC_Users_SetAway(Session *sesion, const char *away);
+
+
+/**
+* @brief Bloquea el indice para leer
+*
+* Mientras se tiene el bloqueo ninguna sesion del indice se libera ni cambia de nick.
+*/
+void IRC_Users_ReadLock();
+
+
+/**
+* @brief Suelta el bloqueo del indice
+*/
+void IRC_Users_Unlock();
+
+
+/**
+* @brief Comprueba si algun usuario tiene un nick
+*
+* @param nick nick buscado, sin distinguir mayusculas
+* @retval TRUE si alguna sesion lo tiene
+* @retval FALSE si esta libre
+*/
+long IRC_Users_Exists(const char *nick);
+
+
+/**
+* @brief Busca la sesion que tiene un nick, hay que tener el bloqueo de lectura
+*
+* @param nick nick buscado, sin distinguir mayusculas
+* @retval Session* la sesion que tiene el nick
+* @retval NULL si nadie lo tiene
+*/
+Session *IRC_Users_Find(const char *nick);
+
+
+/**
+* @brief Busca la sesion de un descriptor
+*
+* @param desc descriptor de la conexion
+* @retval Session* la sesion de ese descriptor
+* @retval NULL si no hay ninguna
+*/
+Session *IRC_Users_Desc(int desc);
+
+
+/**
+* @brief Campo de una sesion por el que se ordena un indice
+*
+* @param sesion sesion
+* @param indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+* @retval const char* nick, user, host o nombre real de la sesion
+*/
+const char *IRC_Users_Field(Session *sesion, int indice);
+
+
+/**
+* @brief Posiciones de un indice cuyo campo empieza por un prefijo, hay que tener el bloqueo de lectura
+*
+* @param indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+* @param prefijo prefijo buscado, sin distinguir mayusculas
+* @param n caracteres del prefijo, 0 para todo el indice
+* @param inicio primera posicion con el prefijo
+* @param fin posicion siguiente a la ultima con el prefijo
+*/
+void IRC_Users_Range(int indice, const char *prefijo, size_t n, int *inicio, int *fin);
+
+
+/**
+* @brief Sesion que ocupa una posicion de un indice, hay que tener el bloqueo de lectura
+*
+* @param indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+* @param posicion posicion dentro de lo que da IRC_Users_Range
+* @retval Session* la sesion de esa posicion
+*/
+Session *IRC_Users_At(int indice, int posicion);
+
+
+/**
+* @brief Primera posicion de un indice que va despues del usuario con ese campo y ese nick, hay que tener el bloqueo de lectura
+*
+* @param indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+* @param clave campo del ultimo usuario revisado
+* @param nick nick del ultimo usuario revisado
+* @retval int la posicion, que puede ser el final del indice
+*/
+int IRC_Users_After(int indice, const char *clave, const char *nick);
+
+#endif
@@ -19,15 +19,6 @@
 #include <sys/stat.h>   /*para unmask*/
 #include <syslog.h>
 
-/**
-* @brief Comprueba si un cliente se ha ido del servidor sin hacer quit
-*
-*
-* @retval TRUE en caso de que el usuario se haya marchado sin hacer QUIT
-* @retval FALSE en caso de que el usuario siga en el servidor
-*/
-long isClosed(int desc);
-
 /**
 * @brief Deja el programa ejecutandose en segundo plano
 *
@@ -36,24 +27,4 @@ long isClosed(int desc);
 */
 void daemonizar();
 
-/**
-* @brief Comprueba si existe un usuario dado su nick
-*
-* @param nick puntero char al nick de usuario
-* @retval TRUE en caso de encontrar un usuario con el nick asociado
-* @retval FALSE en caso de no encontrar un usuario con el nick dado
-*/
-long exist_User(char *nick);
-
-
-/**
-* @brief Comprueba si existe un usuario dado su descriptor
-*
-*
-* @param desc puntero al entero descriptor de usuario
-* @retval TRUE en caso de encontrar un usuario con el descriptor asociado
-* @retval FALSE en caso de no encontrar un usuario con el descriptor dado
-*/
-long exist_descriptor(int* desc);
-
 #endif
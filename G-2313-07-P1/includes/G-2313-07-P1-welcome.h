@@ -0,0 +1,107 @@
+/**
+* @brief Cabeceras de la bienvenida y el MOTD ya preparados
+* @file G-2313-07-P1-welcome.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef WELCOME_H
+#define WELCOME_H
+
+#include <limits.h>     /*PATH_MAX*/
+#include "G-2313-07-P1-server.h"
+#include "G-2313-07-P1-session.h"
+
+
+#define WELCOME_MOTD "/etc/G-2313-07-P1.motd"  /*!<Fichero del MOTD si no se da otro con -m*/
+#define WELCOME_VERSION "G-2313-07-P1-1.2"      /*!<Version que se anuncia en RPL_YOURHOST y RPL_MYINFO*/
+#define WELCOME_UMODOS "aiow"                  /*!<Modos de usuario que se anuncian en RPL_MYINFO*/
+#define WELCOME_CMODOS "biklmnopstv"           /*!<Modos de canal que se anuncian en RPL_MYINFO*/
+#define HUECO_NICK 0     /*!<En el hueco va el nick del cliente*/
+#define HUECO_PREFIJO 1  /*!<En el hueco va "nick!user@host"*/
+
+
+/**
+* @brief Sitio de una plantilla en el que se copia un dato del cliente
+*/
+typedef struct _Hueco {
+	size_t posicion;   /*!<Byte de la plantilla delante del que va el dato*/
+	int campo;         /*!<HUECO_NICK o HUECO_PREFIJO*/
+} Hueco;
+
+
+/**
+* @brief Respuestas ya formateadas con CR/LF a falta de los datos del cliente
+*/
+typedef struct _Plantilla {
+	char *datos;       /*!<Bytes de las lineas sin los datos del cliente*/
+	size_t len;        /*!<Bytes ocupados*/
+	size_t capacidad;  /*!<Bytes reservados*/
+	Hueco *huecos;     /*!<Sitios de los datos del cliente, en orden*/
+	int nhuecos;       /*!<Huecos ocupados*/
+	int reservados;    /*!<Huecos reservados*/
+	int error;         /*!<No hubo memoria al prepararla*/
+} Plantilla;
+
+
+/**
+* @brief Todas las plantillas, se cambian juntas al recargar
+*/
+typedef struct _Bienvenida {
+	Plantilla registro;  /*!<RPL_WELCOME a RPL_ISUPPORT*/
+	Plantilla motd;      /*!<RPL_MOTDSTART, RPL_MOTD y RPL_ENDOFMOTD, o ERR_NOMOTD*/
+} Bienvenida;
+
+
+/**
+* @brief Elige el fichero del MOTD, antes de demonizar porque se guarda la ruta absoluta
+*
+* @param ruta fichero del MOTD
+*/
+void IRC_Welcome_File(const char *ruta);
+
+
+/**
+* @brief Ruta del fichero del MOTD
+*
+* @retval const char* la ruta
+*/
+const char *IRC_Welcome_Path();
+
+
+/**
+* @brief Prepara las plantillas y las cambia por las anteriores
+*
+* @retval TRUE si se han preparado
+* @retval FALSE si no hay memoria, y se siguen usando las anteriores
+*/
+long IRC_Welcome_Load();
+
+
+/**
+* @brief Manejador de SIGHUP, pide recargar las plantillas
+*
+* @param senal señal recibida
+*/
+void IRC_Welcome_Signal(int senal);
+
+
+/**
+* @brief Añade a la respuesta la bienvenida completa de un cliente que se acaba de registrar
+*
+* @param sesion cliente, con la respuesta abierta con IRC_Reply_Begin
+*/
+void IRC_Welcome_Send(Session *sesion);
+
+
+/**
+* @brief Añade a la respuesta el MOTD
+*
+* @param sesion cliente, con la respuesta abierta con IRC_Reply_Begin
+*/
+void IRC_Welcome_Motd(Session *sesion);
+
+#endif
@@ -14,13 +14,40 @@
 #include <redes2/irc.h>
 
 #include "../includes/G-2313-07-P1-server.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-sendq.h"
+#include "../includes/G-2313-07-P1-welcome.h"
 
 
 int main(int argc, char *argv[]){
-	int socket;
+	int socket, i;
+	int hilos = 0, nreactores = 0, nivel = LOG_INFO;
+
+	/*Con -t se usa el modelo de un hilo por cliente en lugar de los reactores*/
+	/*Con -r N se lanzan N reactores, por defecto uno por nucleo*/
+	/*Con -q N se desconecta a los clientes con mas de N bytes pendientes de enviar*/
+	/*Con -l N se registran los mensajes de prioridad N o mas, 7 (LOG_DEBUG) para las trazas*/
+	/*Con -m fichero se lee el MOTD de ese fichero, se vuelve a leer con REHASH o SIGHUP*/
+	for(i = 1; i < argc; i++){
+		if(strcmp(argv[i], "-t") == 0)
+			hilos = 1;
+		else if(strcmp(argv[i], "-r") == 0 && i+1 < argc)
+			nreactores = atoi(argv[++i]);
+		else if(strcmp(argv[i], "-q") == 0 && i+1 < argc)
+			IRC_SendQ_Limit(strtoul(argv[++i], NULL, 10));
+		else if(strcmp(argv[i], "-l") == 0 && i+1 < argc)
+			nivel = atoi(argv[++i]);
+		else if(strcmp(argv[i], "-m") == 0 && i+1 < argc)
+			IRC_Welcome_File(argv[++i]);
+	}
+
 	daemonizar();
+	IRC_Log_Init(nivel);
 	socket = IRC_Initiate_Server();
-	IRC_Accept_Connection(socket);
+	if(hilos)
+		IRC_Accept_Connection(socket);
+	else
+		IRC_Reactor_Run(socket, nreactores);
 
 	return EXIT_SUCCESS;
 }
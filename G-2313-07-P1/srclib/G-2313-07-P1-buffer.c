@@ -0,0 +1,201 @@
+/**
+* @brief Buffers de mensaje inmutables con contador de referencias
+* @file G-2313-07-P1-buffer.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-buffer.h"
+
+/*! @page irc_buffer Buffers compartidos
+*
+* <p>Esta sección incluye los buffers con los que se reparte un mismo mensaje a muchos
+* destinatarios. Cuando se avisa a todo un canal el mensaje se formatea una sola vez en un
+* buffer inmutable, y la cola de salida de cada miembro guarda solo una referencia a el.
+* El buffer se libera cuando la ultima cola lo ha enviado.<br>
+* El contador es atomico porque las colas de distintos reactores sueltan sus referencias
+* desde hilos distintos.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-buffer.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Buffer_New</li>
+* <li>@subpage IRC_Buffer_FromMsg</li>
+* <li>@subpage IRC_Buffer_Ref</li>
+* <li>@subpage IRC_Buffer_Unref</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+/**
+ * @page IRC_Buffer_New IRC_Buffer_New
+ * @brief Crea un buffer compartido con una copia del mensaje
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-buffer.h"
+ *
+ * Buffer *IRC_Buffer_New(const char *datos, size_t len)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Reserva en un solo bloque la cabecera y los datos, y copia el mensaje. El buffer nace con
+ * una referencia, la de quien lo crea, que debe soltarla con IRC_Buffer_Unref al terminar.
+ *
+ * @param[in] datos mensaje que se copia
+ * @param[in] len longitud del mensaje
+ *
+ * @retval Buffer* el buffer creado
+ * @retval NULL si no hay memoria
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Buffer *IRC_Buffer_New(const char *datos, size_t len)
+{
+	Buffer *buffer;
+
+	if((buffer = (Buffer *) malloc(sizeof(Buffer) + len)) == NULL)
+		return NULL;
+
+	atomic_init(&buffer->refs, 1);
+	buffer->len = len;
+	memcpy(buffer->datos, datos, len);
+
+	return buffer;
+}
+
+/**
+ * @page IRC_Buffer_FromMsg IRC_Buffer_FromMsg
+ * @brief Pasa a un buffer compartido un mensaje de la libreria
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-buffer.h"
+ *
+ * Buffer *IRC_Buffer_FromMsg(char *msg)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia en un buffer el mensaje reservado por una funcion IRCMsg_ y libera el original, de forma
+ * que un mensaje para todo un canal se genera una sola vez antes de recorrer a los miembros.
+ *
+ * @param[in] msg mensaje reservado con malloc, se libera siempre
+ *
+ * @retval Buffer* el buffer creado, con una referencia
+ * @retval NULL si msg es NULL o no hay memoria
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Buffer *IRC_Buffer_FromMsg(char *msg)
+{
+	Buffer *buffer;
+
+	if(msg == NULL)
+		return NULL;
+
+	buffer = IRC_Buffer_New(msg, strlen(msg));
+	free(msg);
+
+	return buffer;
+}
+
+/**
+ * @page IRC_Buffer_Ref IRC_Buffer_Ref
+ * @brief Añade una referencia a un buffer compartido
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-buffer.h"
+ *
+ * Buffer *IRC_Buffer_Ref(Buffer *buffer)
+ * @endcode
+ *
+ * @param[in] buffer buffer compartido
+ *
+ * @retval Buffer* el mismo buffer
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Buffer *IRC_Buffer_Ref(Buffer *buffer)
+{
+	atomic_fetch_add_explicit(&buffer->refs, 1, memory_order_relaxed);
+	return buffer;
+}
+
+/**
+ * @page IRC_Buffer_Unref IRC_Buffer_Unref
+ * @brief Suelta una referencia a un buffer compartido
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-buffer.h"
+ *
+ * void IRC_Buffer_Unref(Buffer *buffer)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Quita una referencia y, si era la ultima, libera el buffer.
+ *
+ * @param[in] buffer buffer compartido, puede ser NULL
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Buffer_Unref(Buffer *buffer)
+{
+	if(buffer == NULL)
+		return;
+
+	if(atomic_fetch_sub_explicit(&buffer->refs, 1, memory_order_acq_rel) == 1)
+		free(buffer);
+}
@@ -0,0 +1,1446 @@
+/**
+* @brief Miembros de cada canal en arrays contiguos de sesiones
+* @file G-2313-07-P1-channels.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-channels.h"
+#include "../includes/G-2313-07-P1-users.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-stats.h"
+
+/*! @page irc_channels Miembros de los canales
+*
+* <p>Esta sección incluye la copia que guarda el servidor de quien esta en cada canal. El
+* TAD sigue siendo quien decide los modos, las claves y el topic, pero para repartir un
+* mensaje pedirle la lista de nicks supone copiar cada nick en un array nuevo y despues
+* buscar la sesion de cada uno. Aqui cada canal tiene un array contiguo con las sesiones de
+* sus miembros, de modo que repartir un mensaje es recorrerlo.</p>
+*
+* <p>El array se actualiza en JOIN, PART, KICK y al desconectarse el cliente. Al sacar a un
+* miembro se mueve el ultimo a su hueco, asi el array nunca tiene huecos. Cada sesion
+* guarda tambien los canales en los que esta, para poder sacarla de todos al salir.<br>
+* Los canales estan en una tabla hash con listas y los protege un cerrojo de
+* lectura/escritura. Las sesiones salen de sus canales antes de liberarse, asi que mientras
+* se tiene el bloqueo de lectura todos los miembros siguen vivos.</p>
+*
+* <p>Junto a cada miembro se guarda si es operador o tiene voz, copiado del TAD al entrar y tras
+* cada MODE, para que NAMES y WHOIS pongan los '@' y '+' recorriendo el array sin preguntar al
+* TAD por cada nick.</p>
+*
+* <p>Cada canal guarda ademas su numero de miembros, sus modos y su topic copiados del TAD al
+* crearse y tras cada MODE y TOPIC, asi que LIST no llama al TAD. Todos los canales estan en un
+* indice contiguo ordenado por nombre sin distinguir mayusculas, y con el nombre exacto entre los
+* que solo se distinguen en eso, que solo cambia al crear o borrar canales. LIST y WHO avanzan por
+* partes con el cursor de la sesion, ver @ref irc_cursor.</p>
+*
+* <p>NICK y QUIT se envian una vez a cada usuario que comparte algun canal con quien los hace.
+* Cada aviso tiene un numero nuevo, y al recorrer los canales del usuario cada miembro al que se
+* le envia se queda con ese numero, asi que si se le vuelve a encontrar en otro canal se salta
+* sin buscarle en una lista de ya avisados. Como se escriben las sesiones, se hace con el cerrojo
+* de escritura.</p>
+*
+* <p>LIST recorre el indice por nombre. Con una mascara empieza en el primer canal que empieza
+* por su parte fija y se para en cuanto los canales ya no empiezan por ella, sin recorrer los
+* demas. Entre una cuota y la siguiente el cursor guarda el nombre del ultimo canal revisado, o
+* en el WHO con mascara y el NAMES sin parametros el campo y el nick del ultimo usuario, y sigue
+* desde el siguiente con una busqueda binaria, asi que los canales y usuarios que se crean o se
+* van entre medias no hacen que otros se repitan o se salten.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-channels.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Channels_Join</li>
+* <li>@subpage IRC_Channels_SetModes</li>
+* <li>@subpage IRC_Channels_SetMode</li>
+* <li>@subpage IRC_Channels_SetTopic</li>
+* <li>@subpage IRC_Channels_Part</li>
+* <li>@subpage IRC_Channels_Mine</li>
+* <li>@subpage IRC_Channels_Quit</li>
+* <li>@subpage IRC_Channels_Neighbours</li>
+* <li>@subpage IRC_Channels_Send</li>
+* <li>@subpage IRC_Channels_Deliver</li>
+* <li>@subpage IRC_Channels_List</li>
+* <li>@subpage IRC_Channels_ListFrom</li>
+* <li>@subpage IRC_Channels_WhoFrom</li>
+* <li>@subpage IRC_Channels_WhoMatch</li>
+* <li>@subpage IRC_Channels_Names</li>
+* <li>@subpage IRC_Channels_NamesFrom</li>
+* <li>@subpage IRC_Channels_Whois</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static pthread_rwlock_t cerrojo = PTHREAD_RWLOCK_INITIALIZER; /*!<Protege los canales y sus miembros*/
+static Channel *tabla[CHANNELS_HUECOS];  /*!<Tabla de canales*/
+static Channel **nombres = NULL;         /*!<Todos los canales ordenados por nombre*/
+static int total = 0;                    /*!<Canales en el indice*/
+static int huecos = 0;                   /*!<Huecos reservados en el indice*/
+static unsigned long epoca = 0;          /*!<Ultimo aviso a los vecinos, quien ya lo tiene guarda este numero*/
+
+
+/*Busca un canal por su nombre exacto, como lo distingue el TAD. Hay que tener el cerrojo*/
+static Channel *IRC_Channels_Find(const char *nombre, unsigned long hash)
+{
+	Channel *canal;
+
+	for(canal = tabla[hash & (CHANNELS_HUECOS-1)]; canal != NULL; canal = canal->sig){
+		if(canal->hash == hash && strcmp(canal->nombre, nombre) == 0)
+			return canal;
+	}
+
+	return NULL;
+}
+
+/*Posicion de la sesion en el canal, o -1, mirando sus pocos canales. Hay que tener el cerrojo*/
+static int IRC_Channels_Index(Channel *canal, Session *sesion)
+{
+	int i;
+
+	for(i = 0; i < sesion->ncanales; i++){
+		if(sesion->canales[i] == canal)
+			return sesion->puestos[i];
+	}
+
+	return -1;
+}
+
+/*Apunta en la sesion del miembro i del canal que ahora esta en esa posicion. Hay que tener el cerrojo de escritura*/
+static void IRC_Channels_Moved(Channel *canal, int i)
+{
+	Session *sesion = canal->miembros[i].sesion;
+	int j;
+
+	for(j = 0; j < sesion->ncanales; j++){
+		if(sesion->canales[j] == canal){
+			sesion->puestos[j] = i;
+			return;
+		}
+	}
+}
+
+/*TRUE si la sesion esta en el canal, mirando sus pocos canales. Hay que tener el cerrojo*/
+static long IRC_Channels_In(Channel *canal, Session *sesion)
+{
+	int i;
+
+	for(i = 0; i < sesion->ncanales; i++){
+		if(sesion->canales[i] == canal)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*Simbolo del canal en RPL_NAMREPLY, o NULL si quien pregunta no puede verlo. Hay que tener el cerrojo*/
+static const char *IRC_Channels_Type(Channel *canal, Session *sesion)
+{
+	if((canal->modo & (IRCMODE_SECRET | IRCMODE_PRIVATE)) == 0)
+		return "=";
+	if(IRC_Channels_In(canal, sesion) == FALSE)
+		return NULL;
+
+	return (canal->modo & IRCMODE_SECRET) ? "@" : "*";
+}
+
+/*Linea RPL_LIST de un canal, los secretos solo para sus miembros y los privados sin topic. Hay que tener el cerrojo*/
+static void IRC_Channels_Entry(Channel *canal, Session *sesion)
+{
+	if((canal->modo & (IRCMODE_SECRET | IRCMODE_PRIVATE)) != 0 && IRC_Channels_In(canal, sesion) == FALSE){
+		if((canal->modo & IRCMODE_SECRET) == 0)
+			IRC_Reply_List(canal->nombre, (long) canal->nmiembros, "Prv");
+		return;
+	}
+
+	IRC_Reply_List(canal->nombre, (long) canal->nmiembros, canal->topic != NULL ? canal->topic : "");
+}
+
+/*Primera posicion del indice por nombre que no va antes de los n primeros caracteres de nombre. Hay que tener el cerrojo*/
+static int IRC_Channels_Bound(const char *nombre, size_t n)
+{
+	int inicio = 0, fin = total, medio;
+
+	while(inicio < fin){
+		medio = (inicio + fin) / 2;
+		if(IRC_Users_Compare(nombres[medio]->nombre, nombre, n) < 0)
+			inicio = medio + 1;
+		else
+			fin = medio;
+	}
+
+	return inicio;
+}
+
+/*Primera posicion del indice por nombre que va despues de nombre, desempatando con el nombre exacto. Hay que tener el cerrojo*/
+static int IRC_Channels_After(const char *nombre)
+{
+	int inicio = 0, fin = total, medio, orden;
+
+	while(inicio < fin){
+		medio = (inicio + fin) / 2;
+		if((orden = IRC_Users_Compare(nombres[medio]->nombre, nombre, MAX_CHANNELNAME+1)) == 0)
+			orden = strcmp(nombres[medio]->nombre, nombre);
+		if(orden <= 0)
+			inicio = medio + 1;
+		else
+			fin = medio;
+	}
+
+	return inicio;
+}
+
+/*TRUE si el canal cumple las condiciones del filtro. Hay que tener el cerrojo*/
+static long IRC_Channels_Fits(Channel *canal, const Filtro *filtro, long ahora)
+{
+	long creado = ahora - canal->creado, cambiado = ahora - canal->cambiado;
+
+	if(filtro->mas != FILTRO_NADA && canal->nmiembros <= filtro->mas)
+		return FALSE;
+	if(filtro->menos != FILTRO_NADA && canal->nmiembros >= filtro->menos)
+		return FALSE;
+	if(filtro->creado_mas != FILTRO_NADA && creado <= filtro->creado_mas)
+		return FALSE;
+	if(filtro->creado_menos != FILTRO_NADA && creado >= filtro->creado_menos)
+		return FALSE;
+	if((filtro->topic_mas != FILTRO_NADA || filtro->topic_menos != FILTRO_NADA) && canal->topic == NULL)
+		return FALSE;
+	if(filtro->topic_mas != FILTRO_NADA && cambiado <= filtro->topic_mas)
+		return FALSE;
+	if(filtro->topic_menos != FILTRO_NADA && cambiado >= filtro->topic_menos)
+		return FALSE;
+
+	return (IRC_Mask_Match(&filtro->mascara, canal->nombre) != filtro->negada) ? TRUE : FALSE;
+}
+
+/*Crea un canal vacio en la tabla y en su sitio del indice por nombre. Hay que tener el cerrojo de escritura*/
+static Channel *IRC_Channels_New(const char *nombre, unsigned long hash)
+{
+	Channel *canal, **ampliado;
+	int n;
+
+	if(total == huecos){
+		n = (huecos == 0) ? CHANNELS_INICIAL : huecos*2;
+		ampliado = (Channel **) realloc(nombres, n * sizeof(Channel *));
+		if(ampliado == NULL)
+			return NULL;
+		nombres = ampliado;
+		huecos = n;
+	}
+
+	if((canal = (Channel *) calloc(1, sizeof(Channel))) == NULL)
+		return NULL;
+
+	strncpy(canal->nombre, nombre, MAX_CHANNELNAME);
+	canal->hash = hash;
+	canal->modo = IRCTADChan_GetModeInt(canal->nombre);
+	canal->topic = NULL;
+	canal->autor[0] = '\0';
+	canal->creado = IRC_Timer_Now();
+
+	n = IRC_Channels_After(canal->nombre);
+	memmove(&nombres[n+1], &nombres[n], (total - n) * sizeof(Channel *));
+	nombres[n] = canal;
+	total++;
+
+	canal->sig = tabla[hash & (CHANNELS_HUECOS-1)];
+	tabla[hash & (CHANNELS_HUECOS-1)] = canal;
+	IRC_Stats_Add(STATS_CANALES, 1);
+
+	return canal;
+}
+
+/*Borra un canal de la tabla y del indice por nombre. Hay que tener el cerrojo de escritura*/
+static void IRC_Channels_Delete(Channel *canal)
+{
+	Channel **lista;
+	int n;
+
+	for(lista = &tabla[canal->hash & (CHANNELS_HUECOS-1)]; *lista != canal; lista = &(*lista)->sig);
+	*lista = canal->sig;
+
+	for(n = IRC_Channels_Bound(canal->nombre, sizeof(canal->nombre)); nombres[n] != canal; n++);
+	memmove(&nombres[n], &nombres[n+1], (total - n - 1) * sizeof(Channel *));
+	total--;
+
+	free(canal->topic);
+	free(canal->miembros);
+	free(canal);
+	IRC_Stats_Add(STATS_CANALES, -1);
+}
+
+/*Prefijo de un miembro segun sus modos*/
+static const char *IRC_Channels_Prefix(int modos)
+{
+	if(modos & MIEMBRO_OP)
+		return "@";
+	if(modos & MIEMBRO_VOZ)
+		return "+";
+	return "";
+}
+
+/*Respuesta RPL_NAMREPLY de un canal. Hay que tener los dos cerrojos*/
+static void IRC_Channels_Members(Channel *canal, Session *sesion)
+{
+	Lista lista;
+	const char *tipo;
+	int i;
+
+	if((tipo = IRC_Channels_Type(canal, sesion)) == NULL)
+		return;
+
+	IRC_Reply_NamReply(&lista, tipo, canal->nombre);
+	for(i = 0; i < canal->nmiembros; i++)
+		IRC_Reply_ListAdd(&lista, IRC_Channels_Prefix(canal->miembros[i].modos), canal->miembros[i].sesion->nick);
+	IRC_Reply_ListClose(&lista);
+}
+
+/*Linea RPL_WHOREPLY de un usuario, con H o G segun este ausente y sus modos en el canal*/
+static void IRC_Channels_WhoLine(const char *canal, Session *objetivo, int modos)
+{
+	char estado[3];
+
+	estado[0] = (objetivo->away != NULL) ? 'G' : 'H';
+	strcpy(estado + 1, IRC_Channels_Prefix(modos));
+	IRC_Reply_WhoReply(canal, objetivo->user, objetivo->host, objetivo->nick, estado, objetivo->realname);
+}
+
+/*Envia el buffer una vez a cada sesion que comparte algun canal con la dada, sin ella. Hay que tener el cerrojo de escritura*/
+static void IRC_Channels_Spread(Session *sesion, Buffer *buffer)
+{
+	Channel *canal;
+	Session *miembro;
+	int i, j;
+
+	sesion->marca = ++epoca;
+
+	for(i = 0; i < sesion->ncanales; i++){
+		canal = sesion->canales[i];
+		for(j = 0; j < canal->nmiembros; j++){
+			miembro = canal->miembros[j].sesion;
+			if(miembro->marca != epoca){
+				miembro->marca = epoca;
+				IRC_Reactor_SendBuffer(miembro, buffer);
+			}
+		}
+	}
+}
+
+/*Quita el miembro i del canal y el canal de la sesion, y borra el canal si queda vacio. Hay que tener el cerrojo de escritura*/
+static void IRC_Channels_Remove(Channel *canal, int i)
+{
+	Session *sesion = canal->miembros[i].sesion;
+	int j;
+
+	canal->nmiembros--;
+	canal->miembros[i] = canal->miembros[canal->nmiembros];
+
+	for(j = 0; j < sesion->ncanales; j++){
+		if(sesion->canales[j] == canal){
+			sesion->ncanales--;
+			sesion->canales[j] = sesion->canales[sesion->ncanales];
+			sesion->puestos[j] = sesion->puestos[sesion->ncanales];
+			break;
+		}
+	}
+
+	if(i < canal->nmiembros)
+		IRC_Channels_Moved(canal, i);
+
+	if(canal->nmiembros == 0)
+		IRC_Channels_Delete(canal);
+}
+
+/*Añade la sesion al final del array del canal, creandolo si no existe, o el canal si ya estaba. Hay que tener el cerrojo de escritura*/
+static Channel *IRC_Channels_Add(const char *nombre, Session *sesion, int modos)
+{
+	Channel *canal;
+	Miembro *miembros;
+	unsigned long hash = IRC_Users_Hash(nombre);
+	int i;
+
+	if(strlen(nombre) > MAX_CHANNELNAME)
+		return NULL;
+
+	canal = IRC_Channels_Find(nombre, hash);
+	if(canal != NULL && IRC_Channels_In(canal, sesion) == TRUE)
+		return canal;
+
+	if(sesion->ncanales >= MAX_CHANELS_USER)
+		return NULL;
+
+	if(canal == NULL && (canal = IRC_Channels_New(nombre, hash)) == NULL){
+		IRC_Log(LOG_ERR, "Error allocating channel %s", nombre);
+		return NULL;
+	}
+
+	if(canal->nmiembros == canal->capacidad){
+		i = (canal->capacidad == 0) ? CHANNELS_MIEMBROS : canal->capacidad*2;
+		miembros = (Miembro *) realloc(canal->miembros, i * sizeof(Miembro));
+		if(miembros == NULL){
+			if(canal->nmiembros == 0)
+				IRC_Channels_Delete(canal);
+			IRC_Log(LOG_ERR, "Error growing channel %s", nombre);
+			return NULL;
+		}
+		canal->miembros = miembros;
+		canal->capacidad = i;
+	}
+
+	canal->miembros[canal->nmiembros].sesion = sesion;
+	canal->miembros[canal->nmiembros].modos = modos;
+	sesion->canales[sesion->ncanales] = canal;
+	sesion->puestos[sesion->ncanales++] = canal->nmiembros++;
+
+	return canal;
+}
+
+/**
+ * @page IRC_Channels_Join IRC_Channels_Join
+ * @brief Añade una sesion a varios canales y responde la bienvenida de cada uno
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Join(char **nombres, int *modos, int n, Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se llama despues de que el TAD haya aceptado los canales de un JOIN. Los JOIN para los demas
+ * miembros se formatean antes de tomar los cerrojos, y despues se entra en todos los canales con
+ * una sola toma del de escritura: el canal se crea si es el primer miembro, con los modos que le
+ * da el TAD, y la sesion se añade al final del array, doblandolo si no cabe.<br>
+ * Por cada canal se añaden a la respuesta el JOIN, el topic con RPL_TOPIC y RPL_TOPICWHOTIME si
+ * lo tiene y los nombres con RPL_NAMREPLY y RPL_ENDOFNAMES, asi que el cliente lo recibe todo
+ * de una vez al cerrar la respuesta y no necesita pedir NAMES ni TOPIC.
+ *
+ * @param[in] nombres nombres de los canales
+ * @param[in,out] modos MIEMBRO_OP si la sesion crea el canal, o 0; queda a -1 en los canales en
+ * los que no ha entrado por estar ya en MAX_CHANELS_USER, tener un nombre demasiado largo o no
+ * haber memoria
+ * @param[in] n numero de canales
+ * @param[in] sesion sesion que entra, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Join(char **nombres, int *modos, int n, Session *sesion)
+{
+	Buffer *avisos[MAX_CHANELS_USER];
+	Channel *canal;
+	Session *miembro;
+	long ahora = IRC_Timer_Now(), epoch = (long) time(NULL);
+	int i, j;
+
+	if(n > MAX_CHANELS_USER)
+		n = MAX_CHANELS_USER;
+
+	for(i = 0; i < n; i++)
+		avisos[i] = IRC_Reply_Shared("%s JOIN %s", sesion->prefix, nombres[i]);
+
+	IRC_Users_ReadLock();
+	pthread_rwlock_wrlock(&cerrojo);
+
+	for(i = 0; i < n; i++){
+		if((canal = IRC_Channels_Add(nombres[i], sesion, modos[i])) == NULL){
+			modos[i] = -1;
+			continue;
+		}
+
+		for(j = 0; j < canal->nmiembros && avisos[i] != NULL; j++){
+			miembro = canal->miembros[j].sesion;
+			if(miembro != sesion)
+				IRC_Reactor_SendBuffer(miembro, avisos[i]);
+		}
+
+		IRC_Reply_Line("%s JOIN %s", sesion->prefix, canal->nombre);
+		if(canal->topic != NULL){
+			IRC_Reply_Topic(canal->nombre, canal->topic);
+			IRC_Reply_TopicWhoTime(canal->nombre, canal->autor, epoch - (ahora - canal->cambiado));
+		}
+		IRC_Channels_Members(canal, sesion);
+		IRC_Reply_EndOfNames(canal->nombre);
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+
+	for(i = 0; i < n; i++)
+		IRC_Buffer_Unref(avisos[i]);
+}
+
+/**
+ * @page IRC_Channels_SetModes IRC_Channels_SetModes
+ * @brief Cambia la copia de los modos de un miembro
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_SetModes(const char *nombre, Session *sesion, int modos)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se llama despues de que el TAD acepte un MODE sobre un miembro, con los modos que el TAD
+ * le da ahora, para que el '@' o el '+' de NAMES y WHOIS sigan al TAD.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] sesion miembro
+ * @param[in] modos MIEMBRO_OP y MIEMBRO_VOZ que tiene ahora
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_SetModes(const char *nombre, Session *sesion, int modos)
+{
+	Channel *canal;
+	int i;
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre));
+	if(canal != NULL && (i = IRC_Channels_Index(canal, sesion)) >= 0)
+		canal->miembros[i].modos = modos;
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_SetMode IRC_Channels_SetMode
+ * @brief Cambia la copia de los modos del canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_SetMode(const char *nombre, long modo)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se llama despues de que el TAD acepte un MODE sobre el canal, con los modos que tiene ahora,
+ * para que LIST y NAMES sepan sin preguntar al TAD si es secreto o privado.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] modo modos del canal en el TAD
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_SetMode(const char *nombre, long modo)
+{
+	Channel *canal;
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	if((canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre))) != NULL)
+		canal->modo = modo;
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_SetTopic IRC_Channels_SetTopic
+ * @brief Cambia la copia del topic del canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_SetTopic(const char *nombre, const char *topic, const char *autor)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se llama despues de que el TAD acepte un TOPIC. La copia se reserva aqui y se libera al
+ * cambiarla o al borrar el canal. Si no queda memoria el canal se queda sin topic en LIST.
+ * Se apuntan tambien quien lo pone y cuando, que JOIN responde con RPL_TOPICWHOTIME.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] topic topic nuevo, NULL o vacio si se quita
+ * @param[in] autor nick de quien lo pone
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_SetTopic(const char *nombre, const char *topic, const char *autor)
+{
+	Channel *canal;
+	char *copia = NULL;
+
+	if(topic != NULL && topic[0] != '\0')
+		copia = strdup(topic);
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	if((canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre))) != NULL){
+		free(canal->topic);
+		canal->topic = copia;
+		canal->cambiado = IRC_Timer_Now();
+		strncpy(canal->autor, autor, MAX_NICKNAME);
+		copia = NULL;
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	free(copia);
+}
+
+/**
+ * @page IRC_Channels_Part IRC_Channels_Part
+ * @brief Saca una sesion de un canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Part(const char *nombre, Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se usa tanto en PART como en KICK. El ultimo miembro ocupa el hueco del que sale, y si el
+ * canal se queda vacio se borra de la tabla.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] sesion sesion que sale
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Part(const char *nombre, Session *sesion)
+{
+	Channel *canal;
+	int i;
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre));
+	if(canal != NULL && (i = IRC_Channels_Index(canal, sesion)) >= 0)
+		IRC_Channels_Remove(canal, i);
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_Mine IRC_Channels_Mine
+ * @brief Copia los nombres de los canales en los que esta una sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * int IRC_Channels_Mine(Session *sesion, char nombres[][MAX_CHANNELNAME+1])
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es lo que necesita JOIN 0 para salir de todos sus canales. Los nombres se copian con el
+ * cerrojo tomado porque un KICK desde otro hilo puede cambiar los canales de la sesion.
+ *
+ * @param[in] sesion sesion
+ * @param[out] nombres donde se copian, caben MAX_CHANELS_USER
+ *
+ * @retval int numero de canales
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+int IRC_Channels_Mine(Session *sesion, char nombres[][MAX_CHANNELNAME+1])
+{
+	int i;
+
+	pthread_rwlock_rdlock(&cerrojo);
+	for(i = 0; i < sesion->ncanales; i++)
+		strcpy(nombres[i], sesion->canales[i]->nombre);
+	pthread_rwlock_unlock(&cerrojo);
+
+	return i;
+}
+
+/**
+ * @page IRC_Channels_Quit IRC_Channels_Quit
+ * @brief Saca una sesion de todos sus canales
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Quit(Session *sesion, Buffer *aviso)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Envia el QUIT una vez a cada sesion con la que comparte algun canal, recorre los canales que
+ * guarda la sesion y la saca de cada uno, todo con el mismo bloqueo para que nadie entre en
+ * medio. Lo llama el comando QUIT con el motivo del cliente y despues, sin canales ya, la
+ * liberacion de la sesion, que avisa ella si el cliente se ha ido sin QUIT.
+ *
+ * @param[in] sesion sesion que se desconecta
+ * @param[in] aviso QUIT ya formateado, quien llama conserva su referencia, o NULL para no avisar
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Quit(Session *sesion, Buffer *aviso)
+{
+	Channel *canal;
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	if(aviso != NULL)
+		IRC_Channels_Spread(sesion, aviso);
+
+	while(sesion->ncanales > 0){
+		canal = sesion->canales[sesion->ncanales-1];
+		IRC_Channels_Remove(canal, IRC_Channels_Index(canal, sesion));
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_Neighbours IRC_Channels_Neighbours
+ * @brief Envia un mensaje una sola vez a cada sesion que comparte algun canal con otra
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Neighbours(Session *sesion, Buffer *buffer)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el aviso de un cambio de nick. Recorre una vez los arrays de miembros de los canales de la
+ * sesion y encola a cada miembro una referencia al buffer, saltandose a los que ya lo han recibido
+ * desde otro canal gracias al numero de aviso que guardan. Toma el cerrojo de escritura porque
+ * apunta ese numero en las sesiones.
+ *
+ * @param[in] sesion sesion de la que se avisa, a ella no se le envia
+ * @param[in] buffer mensaje ya formateado, quien llama conserva su referencia
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Neighbours(Session *sesion, Buffer *buffer)
+{
+	if(buffer == NULL)
+		return;
+
+	pthread_rwlock_wrlock(&cerrojo);
+	IRC_Channels_Spread(sesion, buffer);
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_Send IRC_Channels_Send
+ * @brief Envia un mensaje compartido a todos los miembros de un canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * long IRC_Channels_Send(const char *nombre, Buffer *buffer, Session *excepto, long ausentes)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Recorre el array de miembros encolando a cada uno una referencia al buffer, sin copiar
+ * nicks ni reservar memoria. Para saltarse a los ausentes se toma tambien el cerrojo del
+ * indice de usuarios, que es quien protege el mensaje de ausencia, y siempre antes que el
+ * de los canales.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] buffer mensaje ya formateado, quien llama conserva su referencia
+ * @param[in] excepto sesion a la que no se envia, normalmente quien lo origina, o NULL
+ * @param[in] ausentes FALSE para no enviarlo a los miembros ausentes
+ *
+ * @retval TRUE si el canal existe
+ * @retval FALSE si no existe
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Channels_Send(const char *nombre, Buffer *buffer, Session *excepto, long ausentes)
+{
+	Channel *canal;
+	Session *miembro;
+	int i;
+
+	if(ausentes == FALSE)
+		IRC_Users_ReadLock();
+	pthread_rwlock_rdlock(&cerrojo);
+
+	canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre));
+	if(canal != NULL){
+		for(i = 0; i < canal->nmiembros; i++){
+			miembro = canal->miembros[i].sesion;
+			if(miembro != excepto && (ausentes == TRUE || miembro->away == NULL))
+				IRC_Reactor_SendBuffer(miembro, buffer);
+		}
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	if(ausentes == FALSE)
+		IRC_Users_Unlock();
+
+	return (canal != NULL) ? TRUE : FALSE;
+}
+
+/*Entrega el buffer a un miembro si aun no lo tiene. Con dedup hay que tener el cerrojo de escritura*/
+static void IRC_Channels_Once(Session *miembro, Buffer *buffer, long dedup)
+{
+	if(dedup == TRUE){
+		if(miembro->marca == epoca)
+			return;
+		miembro->marca = epoca;
+	}
+	IRC_Reactor_SendBuffer(miembro, buffer);
+}
+
+/**
+ * @page IRC_Channels_Deliver IRC_Channels_Deliver
+ * @brief Entrega un PRIVMSG o NOTICE con varios destinos, una sola vez a cada sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Deliver(char **destinos, Buffer **buffers, int n, Session *sesion, long avisos)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Recorre los destinos en orden con los dos cerrojos tomados una sola vez. Un canal encola su
+ * buffer a los miembros presentes y un nick a su sesion, y quien ya lo ha recibido por un destino
+ * anterior se salta con el mismo numero de aviso que usa IRC_Channels_Neighbours, asi que cada
+ * sesion recibe el mensaje una vez aunque este en varios de los canales. Solo con mas de un destino
+ * hace falta apuntar ese numero y tomar el cerrojo de escritura; con uno basta el de lectura.<br>
+ * Los errores y las ausencias se contestan a quien envia salvo en NOTICE.
+ *
+ * @param[in] destinos nombres de canal o nicks
+ * @param[in] buffers mensaje ya formateado de cada destino, quien llama conserva sus referencias
+ * @param[in] n numero de destinos
+ * @param[in] sesion quien lo envia, no lo recibe por los canales, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] avisos FALSE para NOTICE, que no contesta errores ni ausencias
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Deliver(char **destinos, Buffer **buffers, int n, Session *sesion, long avisos)
+{
+	Channel *canal;
+	Session *miembro;
+	long dedup = (n > 1) ? TRUE : FALSE;
+	int i, j;
+
+	if(n == 0)
+		return;
+
+	IRC_Users_ReadLock();
+	if(dedup == TRUE){
+		pthread_rwlock_wrlock(&cerrojo);
+		epoca++;
+	}else{
+		pthread_rwlock_rdlock(&cerrojo);
+	}
+
+	for(i = 0; i < n; i++){
+		if(destinos[i][0] == '#'){
+			canal = IRC_Channels_Find(destinos[i], IRC_Users_Hash(destinos[i]));
+			if(canal == NULL){
+				if(avisos == TRUE)
+					IRC_Reply_ErrNoSuchChannel(destinos[i]);
+				continue;
+			}
+			/*A los miembros ausentes no se les envia*/
+			for(j = 0; j < canal->nmiembros; j++){
+				miembro = canal->miembros[j].sesion;
+				if(miembro != sesion && miembro->away == NULL)
+					IRC_Channels_Once(miembro, buffers[i], dedup);
+			}
+		}else{
+			miembro = IRC_Users_Find(destinos[i]);
+			if(miembro == NULL || miembro->estado != SESION_REGISTRADA){
+				if(avisos == TRUE)
+					IRC_Reply_ErrNoSuchNick(destinos[i]);
+			}else if(miembro->away != NULL){
+				if(avisos == TRUE)
+					IRC_Reply_Away(miembro->nick, miembro->away);
+			}else{
+				IRC_Channels_Once(miembro, buffers[i], dedup);
+			}
+		}
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+}
+
+/**
+ * @page IRC_Channels_List IRC_Channels_List
+ * @brief Responde RPL_LIST con un canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_List(const char *nombre, Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el LIST con nombres de canal. Añade la linea RPL_LIST del canal con los miembros, los modos
+ * y el topic que guarda, sin llamar al TAD. Un canal secreto solo sale a sus miembros y uno
+ * privado sale sin topic.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_List(const char *nombre, Session *sesion)
+{
+	Channel *canal;
+
+	pthread_rwlock_rdlock(&cerrojo);
+
+	if((canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre))) != NULL)
+		IRC_Channels_Entry(canal, sesion);
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Channels_ListFrom IRC_Channels_ListFrom
+ * @brief Responde RPL_LIST con los canales que cumplen un filtro despues del ultimo revisado
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * long IRC_Channels_ListFrom(Filtro *filtro, Session *sesion, size_t cuota)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el LIST sin parametros o con filtros, por partes. Recorre el indice por nombre y añade una
+ * linea RPL_LIST, igual que IRC_Channels_List, por cada canal que cumple el filtro. La primera
+ * llamada empieza en el primer canal que empieza por la parte fija de la mascara si la tiene, o
+ * en el primero si no, y las siguientes en el canal que va despues del ultimo revisado, que se
+ * guarda en el filtro. Se para al generar cuota bytes o revisar cuota canales, y termina al
+ * llegar al final o a un canal que ya no empieza por el prefijo, porque los siguientes tampoco.
+ *
+ * @param[in,out] filtro condiciones de los canales, guarda el nombre del ultimo canal revisado
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] cuota bytes de respuesta y canales revisados tras los que se para
+ *
+ * @retval TRUE si ha terminado
+ * @retval FALSE si quedan canales
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Channels_ListFrom(Filtro *filtro, Session *sesion, size_t cuota)
+{
+	Channel *canal;
+	size_t limite = IRC_Reply_Written() + cuota, revisados;
+	long terminado = FALSE, ahora = IRC_Timer_Now();
+	int prefijo = (filtro->negada == FALSE) ? filtro->mascara.prefijo : 0, posicion;
+
+	pthread_rwlock_rdlock(&cerrojo);
+
+	if(filtro->indice == FILTRO_NINGUNO){
+		filtro->indice = FILTRO_NOMBRES;
+		posicion = (prefijo > 0) ? IRC_Channels_Bound(filtro->mascara.patron, prefijo) : 0;
+	}else{
+		posicion = IRC_Channels_After(filtro->ultimo);
+	}
+
+	for(revisados = 0; posicion < total && revisados < cuota && IRC_Reply_Written() < limite; posicion++, revisados++){
+		canal = nombres[posicion];
+		if(prefijo > 0 && IRC_Users_Compare(canal->nombre, filtro->mascara.patron, prefijo) != 0){
+			posicion = total;
+			break;
+		}
+		if(IRC_Channels_Fits(canal, filtro, ahora) == TRUE)
+			IRC_Channels_Entry(canal, sesion);
+		strcpy(filtro->ultimo, canal->nombre);
+	}
+	if(posicion >= total)
+		terminado = TRUE;
+
+	pthread_rwlock_unlock(&cerrojo);
+
+	return terminado;
+}
+
+/**
+ * @page IRC_Channels_WhoFrom IRC_Channels_WhoFrom
+ * @brief Responde RPL_WHOREPLY con los miembros de un canal a partir de una posicion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * long IRC_Channels_WhoFrom(const Filtro *filtro, long *posicion, Session *sesion, size_t cuota)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el WHO de un canal, por partes. Recorre el array de miembros desde la posicion dada y añade
+ * una linea RPL_WHOREPLY por miembro con los datos de su sesion, H o G segun este ausente y su
+ * '@' o '+', hasta generar cuota bytes o llegar al final, sin pedir nada al TAD. Un canal
+ * secreto o privado solo se muestra a sus miembros, y con la o del WHO solo salen sus operadores.
+ *
+ * @param[in] filtro canal en la mascara y si solo se quieren operadores
+ * @param[in,out] posicion siguiente miembro del canal
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] cuota bytes de respuesta tras los que se para
+ *
+ * @retval TRUE si ha llegado al final o el canal no existe
+ * @retval FALSE si quedan miembros
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Channels_WhoFrom(const Filtro *filtro, long *posicion, Session *sesion, size_t cuota)
+{
+	Channel *canal;
+	Miembro *miembro;
+	const char *nombre = filtro->mascara.patron;
+	size_t limite = IRC_Reply_Written() + cuota;
+	long terminado = TRUE;
+
+	IRC_Users_ReadLock();
+	pthread_rwlock_rdlock(&cerrojo);
+
+	canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre));
+	if(canal != NULL && IRC_Channels_Type(canal, sesion) != NULL){
+		for(; *posicion < canal->nmiembros && IRC_Reply_Written() < limite; (*posicion)++){
+			miembro = &canal->miembros[*posicion];
+			if(filtro->operadores == FALSE || (miembro->modos & MIEMBRO_OP))
+				IRC_Channels_WhoLine(canal->nombre, miembro->sesion, miembro->modos);
+		}
+		terminado = (*posicion >= canal->nmiembros) ? TRUE : FALSE;
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+
+	return terminado;
+}
+
+/**
+ * @page IRC_Channels_WhoMatch IRC_Channels_WhoMatch
+ * @brief Responde RPL_WHOREPLY con los usuarios que cumplen una mascara despues del ultimo revisado
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * long IRC_Channels_WhoMatch(Filtro *filtro, Session *sesion, size_t cuota)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el WHO con una mascara, por partes. Un usuario sale si la mascara cumple su nick, su user,
+ * su host o su nombre real, y con la o del WHO solo si es operador de alguno de sus canales, ya
+ * que el servidor no tiene operadores de red. Cada linea lleva el primer canal del usuario que
+ * puede ver quien pregunta, o '*'.
+ *
+ * Si la mascara empieza por caracteres fijos se recorren, uno detras de otro, los tramos de los
+ * indices de nick, user, host y nombre real que empiezan por ellos, y cada usuario sale solo en
+ * el tramo del primer campo que cumple la mascara, asi no se repite. Si no, se recorre entero el
+ * indice de nicks. Se para al generar cuota bytes o revisar cuota usuarios, aunque ninguno
+ * haya cumplido la mascara y no se haya escrito nada. El filtro guarda el campo y el nick del
+ * ultimo usuario revisado, y la siguiente llamada sigue con IRC_Users_After desde el que va
+ * despues, asi que los usuarios que se registran, cambian de nick o se van entre medias no
+ * hacen que otros se repitan o se salten.
+ *
+ * @param[in,out] filtro mascara y si solo se quieren operadores, guarda el indice que recorre y el ultimo usuario revisado
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] cuota bytes de respuesta y usuarios revisados tras los que se para
+ *
+ * @retval TRUE si ha terminado
+ * @retval FALSE si quedan usuarios
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Channels_WhoMatch(Filtro *filtro, Session *sesion, size_t cuota)
+{
+	Session *objetivo;
+	Channel *canal;
+	const char *visible;
+	size_t limite = IRC_Reply_Written() + cuota, revisados = 0;
+	int prefijo = filtro->mascara.prefijo, final = (prefijo > 0) ? USERS_REAL : USERS_NICK;
+	int inicio, fin, posicion, campo, modos, operador, i, j;
+	long terminado = FALSE;
+
+	IRC_Users_ReadLock();
+	pthread_rwlock_rdlock(&cerrojo);
+
+	if(filtro->indice == FILTRO_NINGUNO){
+		filtro->indice = FILTRO_USUARIOS;
+		filtro->campo = USERS_NICK;
+		filtro->nick[0] = '\0';
+	}
+
+	while(terminado == FALSE && revisados < cuota && IRC_Reply_Written() < limite){
+		IRC_Users_Range(filtro->campo, filtro->mascara.patron, prefijo, &inicio, &fin);
+		posicion = inicio;
+		if(filtro->nick[0] != '\0' && (posicion = IRC_Users_After(filtro->campo, filtro->ultimo, filtro->nick)) < inicio)
+			posicion = inicio;
+
+		for(; posicion < fin && revisados < cuota && IRC_Reply_Written() < limite; posicion++, revisados++){
+			objetivo = IRC_Users_At(filtro->campo, posicion);
+			strcpy(filtro->ultimo, IRC_Users_Field(objetivo, filtro->campo));
+			strcpy(filtro->nick, objetivo->nick);
+
+			/*Solo en el tramo del primer campo que cumple la mascara*/
+			for(campo = USERS_NICK; campo < USERS_INDICES; campo++){
+				if(IRC_Mask_Match(&filtro->mascara, IRC_Users_Field(objetivo, campo)) == TRUE)
+					break;
+			}
+			if(campo == USERS_INDICES || (prefijo > 0 && campo != filtro->campo))
+				continue;
+
+			visible = "*";
+			modos = 0;
+			operador = FALSE;
+			for(i = 0; i < objetivo->ncanales; i++){
+				canal = objetivo->canales[i];
+				j = objetivo->puestos[i];
+				if(canal->miembros[j].modos & MIEMBRO_OP)
+					operador = TRUE;
+				if(visible[0] == '*' && IRC_Channels_Type(canal, sesion) != NULL){
+					visible = canal->nombre;
+					modos = canal->miembros[j].modos;
+				}
+			}
+
+			if(filtro->operadores == FALSE || operador == TRUE)
+				IRC_Channels_WhoLine(visible, objetivo, modos);
+		}
+
+		if(posicion >= fin){
+			if(filtro->campo == final){
+				terminado = TRUE;
+			}else{
+				filtro->campo++;
+				filtro->nick[0] = '\0';
+			}
+		}
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+
+	return terminado;
+}
+
+/**
+ * @page IRC_Channels_Names IRC_Channels_Names
+ * @brief Responde RPL_NAMREPLY con los miembros de un canal
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Names(const char *nombre, Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Recorre el array de miembros una vez y añade cada nick con su '@' o '+' a la respuesta, que se
+ * parte en varias lineas RPL_NAMREPLY si no cabe en una. Un canal secreto o privado solo se
+ * muestra a sus miembros. El RPL_ENDOFNAMES lo añade quien llama.
+ *
+ * @param[in] nombre nombre del canal
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Names(const char *nombre, Session *sesion)
+{
+	Channel *canal;
+
+	IRC_Users_ReadLock();
+	pthread_rwlock_rdlock(&cerrojo);
+
+	if((canal = IRC_Channels_Find(nombre, IRC_Users_Hash(nombre))) != NULL)
+		IRC_Channels_Members(canal, sesion);
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+}
+
+/**
+ * @page IRC_Channels_NamesFrom IRC_Channels_NamesFrom
+ * @brief Responde RPL_NAMREPLY con todos los canales y los usuarios sin canal despues del ultimo revisado
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * long IRC_Channels_NamesFrom(Filtro *filtro, Session *sesion, size_t cuota)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el NAMES sin parametros, por partes. Primero recorre el indice de nombres de canales y
+ * responde por cada canal que el cliente puede ver como lo haria IRC_Channels_Names, y despues el
+ * indice de nicks del modulo de usuarios, que solo tiene a los registrados, con los que no estan
+ * en ningun canal bajo el canal "*". Se para al generar cuota bytes o revisar cuota canales o
+ * usuarios, y las lineas del canal "*" se cierran al final de cada llamada. El filtro guarda el
+ * nombre del ultimo canal o el nick del ultimo usuario revisado, y la siguiente llamada sigue
+ * desde el que va despues, asi que los canales y usuarios que se crean o se van entre medias no
+ * hacen que otros se repitan o se salten.
+ *
+ * @param[in,out] filtro guarda el indice que recorre, FILTRO_NOMBRES y luego FILTRO_USUARIOS, y el ultimo canal o usuario revisado
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] cuota bytes de respuesta y canales o usuarios revisados tras los que se para
+ *
+ * @retval TRUE si ha terminado
+ * @retval FALSE si quedan canales o usuarios
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Channels_NamesFrom(Filtro *filtro, Session *sesion, size_t cuota)
+{
+	Session *usuario;
+	Lista lista;
+	size_t limite = IRC_Reply_Written() + cuota, revisados = 0;
+	int posicion, inicio, fin;
+	long terminado = FALSE;
+
+	IRC_Users_ReadLock();
+	pthread_rwlock_rdlock(&cerrojo);
+
+	if(filtro->indice == FILTRO_NINGUNO){
+		filtro->indice = FILTRO_NOMBRES;
+		filtro->ultimo[0] = '\0';
+	}
+
+	if(filtro->indice == FILTRO_NOMBRES){
+		posicion = (filtro->ultimo[0] != '\0') ? IRC_Channels_After(filtro->ultimo) : 0;
+		for(; posicion < total && revisados < cuota && IRC_Reply_Written() < limite; posicion++, revisados++){
+			IRC_Channels_Members(nombres[posicion], sesion);
+			strcpy(filtro->ultimo, nombres[posicion]->nombre);
+		}
+		if(posicion >= total){
+			filtro->indice = FILTRO_USUARIOS;
+			filtro->nick[0] = '\0';
+		}
+	}
+
+	if(filtro->indice == FILTRO_USUARIOS && revisados < cuota && IRC_Reply_Written() < limite){
+		IRC_Users_Range(USERS_NICK, "", 0, &inicio, &fin);
+		posicion = inicio;
+		if(filtro->nick[0] != '\0' && (posicion = IRC_Users_After(USERS_NICK, filtro->nick, filtro->nick)) < inicio)
+			posicion = inicio;
+
+		IRC_Reply_NamReply(&lista, "*", "*");
+		for(; posicion < fin && revisados < cuota && IRC_Reply_Written() < limite; posicion++, revisados++){
+			usuario = IRC_Users_At(USERS_NICK, posicion);
+			if(usuario->ncanales == 0)
+				IRC_Reply_ListAdd(&lista, "", usuario->nick);
+			strcpy(filtro->nick, usuario->nick);
+		}
+		IRC_Reply_ListClose(&lista);
+		terminado = (posicion >= fin) ? TRUE : FALSE;
+	}
+
+	pthread_rwlock_unlock(&cerrojo);
+	IRC_Users_Unlock();
+
+	return terminado;
+}
+
+/**
+ * @page IRC_Channels_Whois IRC_Channels_Whois
+ * @brief Responde RPL_WHOISCHANNELS con los canales de un usuario
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-channels.h"
+ *
+ * void IRC_Channels_Whois(Session *objetivo, Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Recorre los canales que guarda la sesion del usuario y añade cada uno con el '@' o '+' que
+ * tiene en el, partiendo la respuesta en varias lineas si hace falta. Los canales secretos o
+ * privados solo salen si quien pregunta tambien esta en ellos.
+ *
+ * @param[in] objetivo usuario por el que se pregunta
+ * @param[in] sesion cliente que lo pide, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * @warning Hay que tener el bloqueo de lectura del indice de usuarios, con el que se ha
+ * encontrado al objetivo.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Channels_Whois(Session *objetivo, Session *sesion)
+{
+	Channel *canal;
+	Lista lista;
+	int i, j;
+
+	pthread_rwlock_rdlock(&cerrojo);
+
+	IRC_Reply_WhoisChannels(&lista, objetivo->nick);
+	for(i = 0; i < objetivo->ncanales; i++){
+		canal = objetivo->canales[i];
+		if(IRC_Channels_Type(canal, sesion) != NULL && (j = IRC_Channels_Index(canal, objetivo)) >= 0)
+			IRC_Reply_ListAdd(&lista, IRC_Channels_Prefix(canal->miembros[j].modos), canal->nombre);
+	}
+	IRC_Reply_ListClose(&lista);
+
+	pthread_rwlock_unlock(&cerrojo);
+}
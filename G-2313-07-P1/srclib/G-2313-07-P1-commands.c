@@ -0,0 +1,999 @@
+/**
+* @brief Tabla de comandos del servidor y sus manejadores
+* @file G-2313-07-P1-commands.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-commands.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-users.h"
+#include "../includes/G-2313-07-P1-channels.h"
+#include "../includes/G-2313-07-P1-resolver.h"
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-cursor.h"
+#include "../includes/G-2313-07-P1-welcome.h"
+#include "../includes/G-2313-07-P1-stats.h"
+
+/*! @page irc_commands Tabla de comandos
+*
+* <p>Esta sección incluye la tabla con la que IRC_Server_Parser reparte los comandos.</p>
+*
+* <p>La linea se separa una vez con IRC_Commands_Split en etiquetas, prefijo, verbo y
+* parametros, trozos que apuntan a la propia linea del buffer de entrada, asi que ningun comando
+* reserva memoria para leer sus argumentos. El verbo se busca en una tabla de COMANDOS_HUECOS huecos con un hash perfecto: al arrancar,
+* IRC_Commands_Init prueba semillas hasta que cada comando cae en un hueco distinto. Buscar un
+* comando es calcular el hash de sus pocas letras, mirar un hueco y comparar una cadena, sin
+* recorrer nada, tambien para los mas frecuentes como PRIVMSG, PING y PONG.<br>
+* Cada entrada dice los parametros minimos y maximos del comando y si hace falta estar registrado,
+* asi los manejadores no repiten esas comprobaciones. Para añadir un comando basta con escribir su
+* manejador y su linea en la tabla.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-commands.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Commands_Init</li>
+* <li>@subpage IRC_Commands_Split</li>
+* <li>@subpage IRC_Commands_Find</li>
+* <li>@subpage IRC_Commands_Register</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static long IRC_Commands_Pass(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Nick(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_User(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Join(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_List(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Names(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Who(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Whois(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Pong(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Ping(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Privmsg(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Notice(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Part(Session *sesion, Mensaje *mensaje);
+static void IRC_Commands_Leave(Session *sesion, char *channel);
+static long IRC_Commands_Topic(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Mode(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Kick(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Away(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Quit(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Motd(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Rehash(Session *sesion, Mensaje *mensaje);
+static long IRC_Commands_Lusers(Session *sesion, Mensaje *mensaje);
+
+/*Comandos implementados: verbo, manejador, parametros minimos y maximos y si exige registro*/
+static const Comando comandos[] = {
+	{"PASS",    IRC_Commands_Pass,    1, 1,          FALSE},
+	{"NICK",    IRC_Commands_Nick,    0, 1,          FALSE},
+	{"USER",    IRC_Commands_User,    4, 4,          FALSE},
+	{"PING",    IRC_Commands_Ping,    1, 2,          FALSE},
+	{"PONG",    IRC_Commands_Pong,    0, 2,          FALSE},
+	{"QUIT",    IRC_Commands_Quit,    0, 1,          FALSE},
+	{"PRIVMSG", IRC_Commands_Privmsg, 0, 2,          TRUE},
+	{"NOTICE",  IRC_Commands_Notice,  0, 2,          TRUE},
+	{"JOIN",    IRC_Commands_Join,    1, 2,          TRUE},
+	{"PART",    IRC_Commands_Part,    1, 2,          TRUE},
+	{"LIST",    IRC_Commands_List,    0, 2,          TRUE},
+	{"NAMES",   IRC_Commands_Names,   0, 2,          TRUE},
+	{"WHO",     IRC_Commands_Who,     0, 2,          TRUE},
+	{"WHOIS",   IRC_Commands_Whois,   0, 2,          TRUE},
+	{"TOPIC",   IRC_Commands_Topic,   1, 2,          TRUE},
+	{"MODE",    IRC_Commands_Mode,    1, MAX_PARAMS, TRUE},
+	{"KICK",    IRC_Commands_Kick,    2, 3,          TRUE},
+	{"AWAY",    IRC_Commands_Away,    0, 1,          TRUE},
+	{"MOTD",    IRC_Commands_Motd,    0, 1,          TRUE},
+	{"REHASH",  IRC_Commands_Rehash,  0, 0,          TRUE},
+	{"LUSERS",  IRC_Commands_Lusers,  0, 2,          TRUE}
+};
+
+#define NCOMANDOS ((int) (sizeof(comandos) / sizeof(comandos[0]))) /*!<Entradas de la tabla*/
+
+static const Comando *tabla[COMANDOS_HUECOS]; /*!<Hueco de cada comando segun el hash*/
+static unsigned int semilla = 0;              /*!<Semilla con la que no hay colisiones*/
+
+
+/*FNV-1a de las letras del verbo pasadas a mayusculas, reducido a un hueco*/
+static unsigned int IRC_Commands_Hash(const char *verbo, unsigned int inicial)
+{
+	unsigned int hash = inicial;
+
+	for(; *verbo != '\0'; verbo++)
+		hash = (hash ^ (unsigned char) (*verbo & 0xDF)) * 16777619u;
+
+	return (hash >> 16) & (COMANDOS_HUECOS - 1);
+}
+
+/**
+ * @page IRC_Commands_Init IRC_Commands_Init
+ * @brief Busca una semilla con la que el hash de los comandos no tenga colisiones
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-commands.h"
+ *
+ * void IRC_Commands_Init()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Prueba semillas a partir de la base de FNV hasta que cada comando de la tabla cae en un hueco
+ * distinto y rellena la tabla de huecos. Con menos de una veintena de comandos en 64 huecos se
+ * encuentra en pocas vueltas. Se llama una vez al iniciar el servidor, antes de aceptar clientes.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Commands_Init()
+{
+	unsigned int prueba, hueco;
+	int i;
+
+	for(prueba = 2166136261u; ; prueba++){
+		memset(tabla, 0, sizeof(tabla));
+		for(i = 0; i < NCOMANDOS; i++){
+			hueco = IRC_Commands_Hash(comandos[i].verbo, prueba);
+			if(tabla[hueco] != NULL)
+				break;
+			tabla[hueco] = &comandos[i];
+		}
+		if(i == NCOMANDOS)
+			break;
+	}
+
+	semilla = prueba;
+	IRC_Debug("Tabla de comandos con semilla %u", semilla);
+}
+
+/*Corta el trozo que empieza en p hasta el siguiente espacio, devuelve donde sigue la linea*/
+static char *IRC_Commands_Cut(char *p, Trozo *trozo)
+{
+	trozo->texto = p;
+	while(*p != ' ' && *p != '\0')
+		p++;
+	trozo->len = p - trozo->texto;
+
+	if(*p == '\0')
+		return p;
+	*p++ = '\0';
+	while(*p == ' ')
+		p++;
+	return p;
+}
+
+/**
+ * @page IRC_Commands_Split IRC_Commands_Split
+ * @brief Separa una linea en etiquetas, prefijo, verbo y parametros
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-commands.h"
+ *
+ * long IRC_Commands_Split(char *command, Mensaje *mensaje)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Recorre la linea una vez y deja en el mensaje un trozo, puntero y longitud, por cada parte, sin
+ * copiar nada ni reservar memoria. Cada separador se sustituye por '\0' para que los manejadores
+ * puedan pasar los trozos como cadenas al TAD. Un parametro que empieza por ':' se lleva el resto
+ * de la linea, igual que el parametro numero MAX_PARAMS.
+ *
+ * @param[in,out] command linea recibida sin CR/LF, dentro del buffer de entrada de la conexion
+ * @param[out] mensaje mensaje que se rellena
+ *
+ * @retval TRUE si la linea tiene verbo
+ * @retval FALSE si esta vacia o solo tiene etiquetas o prefijo
+ *
+ * @warning Los trozos apuntan a la linea, que solo vale hasta la siguiente llamada a IRC_Framer_Read.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Commands_Split(char *command, Mensaje *mensaje)
+{
+	char *p = command;
+
+	mensaje->tags.texto = mensaje->prefix.texto = mensaje->verbo.texto = NULL;
+	mensaje->tags.len = mensaje->prefix.len = mensaje->verbo.len = 0;
+	mensaje->nparams = 0;
+
+	while(*p == ' ')
+		p++;
+	if(*p == '@')
+		p = IRC_Commands_Cut(p + 1, &mensaje->tags);
+	if(*p == ':')
+		p = IRC_Commands_Cut(p + 1, &mensaje->prefix);
+	if(*p == '\0')
+		return FALSE;
+	p = IRC_Commands_Cut(p, &mensaje->verbo);
+
+	while(*p != '\0'){
+		if(*p == ':' || mensaje->nparams == MAX_PARAMS - 1){
+			if(*p == ':')
+				p++;
+			mensaje->params[mensaje->nparams].texto = p;
+			mensaje->params[mensaje->nparams++].len = strlen(p);
+			break;
+		}
+		p = IRC_Commands_Cut(p, &mensaje->params[mensaje->nparams++]);
+	}
+
+	return TRUE;
+}
+
+/**
+ * @page IRC_Commands_Find IRC_Commands_Find
+ * @brief Busca un comando en la tabla
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-commands.h"
+ *
+ * const Comando *IRC_Commands_Find(const char *verbo)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Calcula el hueco del verbo con la semilla elegida en IRC_Commands_Init y compara con el unico
+ * comando que puede estar en el. No distingue mayusculas.
+ *
+ * @param[in] verbo comando recibido
+ *
+ * @retval Comando* la entrada del comando
+ * @retval NULL si el servidor no lo implementa
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+const Comando *IRC_Commands_Find(const char *verbo)
+{
+	const Comando *comando = tabla[IRC_Commands_Hash(verbo, semilla)];
+
+	if(comando == NULL || strcasecmp(comando->verbo, verbo) != 0)
+		return NULL;
+
+	return comando;
+}
+
+/**
+ * @page IRC_Commands_Register IRC_Commands_Register
+ * @brief Da de alta al usuario si la sesion ya tiene NICK, USER y el host definitivo
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-commands.h"
+ *
+ * void IRC_Commands_Register(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La llaman NICK y USER al apuntar su parte y IRC_Server_Resume cuando el resolvedor termina.
+ * Si la sesion esta en SESION_ESPERA y el host ya es definitivo, crea el usuario en el TAD,
+ * compone el prefijo y envia la bienvenida. Si el TAD no acepta el nick se quita el paso de
+ * NICK para que el cliente elija otro.
+ *
+ * @param[in,out] sesion sesion del cliente
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Commands_Register(Session *sesion)
+{
+	if(sesion->estado != SESION_ESPERA || IRC_Resolver_Host(sesion) == FALSE)
+		return;
+
+	IRC_Reply_Begin(sesion);
+	if(IRCTADUser_New(sesion->user, sesion->nick, sesion->realname, NULL, sesion->host, sesion->ip, sesion->desc) != IRC_OK){
+		/*Hace falta otro NICK para volver a intentarlo*/
+		sesion->estado &= ~SESION_NICK;
+		IRC_Reply_ErrNicknameInUse(sesion->nick);
+		IRC_Reply_End();
+		return;
+	}
+
+	IRC_Users_SetPrefix(sesion);
+	sesion->estado = SESION_REGISTRADA;
+	IRC_Stats_Add(STATS_DESCONOCIDAS, -1);
+	IRC_Stats_Add(STATS_USUARIOS, 1);
+	IRC_Debug("PREFIX NUEVO %s", sesion->prefix);
+
+	/* Mensaje de Bienvenida, con el MOTD*/
+	IRC_Welcome_Send(sesion);
+	IRC_Reply_End();
+}
+
+/************************************ PASS ****************************************************/
+/*No se comprueba contraseña, se acepta para no romper a los clientes que la envian*/
+static long IRC_Commands_Pass(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Debug("CASE PASSS\n");
+	return FALSE;
+}
+
+/************************************ NICK ****************************************************/
+static long IRC_Commands_Nick(Session *sesion, Mensaje *mensaje)
+{
+	Buffer *buffer;
+	Session *duenno;
+	char *nick_pars;
+	char anterior[MAX_PREFIX], nick_anterior[MAX_NICKNAME+1];
+
+	if(mensaje->nparams < 1){
+		IRC_Debug("NICK => ERROR sin nick");
+		IRC_Reply_ErrNoNicknameGiven();
+		return FALSE;
+	}
+	nick_pars = PARAM(mensaje, 0);
+
+	/*El propio nick, aunque cambien las mayusculas, no cuenta como en uso*/
+	IRC_Users_ReadLock();
+	duenno = IRC_Users_Find(nick_pars);
+	IRC_Users_Unlock();
+
+	if(strlen(nick_pars) > MAX_NICKNAME){
+		IRC_Debug("Longitud maxima superada\n");
+		IRC_Reply_ErrErroneusNickname(nick_pars);
+	}else if(strcmp(nick_pars, sesion->nick) == 0){
+		IRC_Debug("NICK %s => SIN CAMBIOS\n", nick_pars);
+	}else if(duenno != NULL && duenno != sesion){
+		IRC_Debug("NICK %s => EN USO\n", nick_pars);
+		IRC_Reply_ErrNicknameInUse(nick_pars);
+
+	}else{
+		IRC_Debug("CASE NICK => CORRECTO\n");
+		strcpy(nick_anterior, sesion->nick);
+		strcpy(anterior, sesion->prefix);
+
+		/*Se reserva en el indice, si otro lo ha cogido a la vez se le avisa como en uso*/
+		if(IRC_Users_SetNick(sesion, nick_pars) == FALSE){
+			IRC_Reply_ErrNicknameInUse(nick_pars);
+		}else if(sesion->estado != SESION_REGISTRADA){
+			sesion->estado |= SESION_NICK;
+			IRC_Commands_Register(sesion);
+		}else if(IRCTADUser_Set(0, NULL, nick_anterior, NULL, NULL, nick_pars, NULL) != IRC_OK){
+			IRC_Debug("CASE NICK => ERROR EN EL TAD\n");
+			IRC_Users_SetNick(sesion, nick_anterior);
+			IRC_Reply_ErrNicknameInUse(nick_pars);
+		}else{
+			/*El cambio se anuncia con el prefijo anterior, el nuevo ya lo ha compuesto IRC_Users_SetNick*/
+			IRC_Reply_Line("%s NICK :%s", anterior, nick_pars);
+			IRC_Debug("PREFIX NUEVO %s", sesion->prefix);
+
+			/*Una sola vez a cada uno de los que estan en algun canal con el*/
+			buffer = IRC_Reply_Shared("%s NICK :%s", anterior, nick_pars);
+			IRC_Channels_Neighbours(sesion, buffer);
+			IRC_Buffer_Unref(buffer);
+		}
+	}
+
+	return FALSE;
+}
+
+/************************************ USER ****************************************************/
+/*USER user modo servidor :nombre real*/
+static long IRC_Commands_User(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Debug("CASE USER\n");
+	if((sesion->estado & SESION_USER) == SESION_USER){
+		IRC_Reply_ErrAlreadyRegistred();
+		return FALSE;
+	}
+
+	snprintf(sesion->user, sizeof(sesion->user), "%s", PARAM(mensaje, 0));
+	snprintf(sesion->realname, sizeof(sesion->realname), "%s", PARAM(mensaje, 3));
+	sesion->estado |= SESION_USER;
+
+	/*Si el resolvedor aun no tiene el host se termina en IRC_Server_Resume*/
+	IRC_Commands_Register(sesion);
+
+	return FALSE;
+}
+
+/************************************ JOIN ****************************************************/
+/*Comprueba un canal de JOIN y lo une en el TAD. TRUE si lo ha aceptado, con los modos de la copia*/
+static long IRC_Commands_Enter(Session *sesion, char *channel, char *key, int *modos)
+{
+	char mode[2];
+
+	/*Comprobamos que empiece por #*/
+	if(channel[0] != '#') {
+		IRC_Debug("CANAL INCORRECTO: %s", channel);
+		IRC_Reply_ErrNoSuchChannel(channel);
+		return FALSE;
+	}
+
+	/*Si el canal no existe establecemos al usuario como operador*/
+	if(IRCTAD_TestUserOnChannel (channel, sesion->nick) == IRCERR_NOVALIDCHANNEL){
+		strcpy(mode, "o");
+	}else{
+		strcpy(mode, "");
+	}
+
+	if((IRCTADChan_GetModeInt (channel) & IRCMODE_CHANNELPASSWORD ) == IRCMODE_CHANNELPASSWORD){
+		if(IRCTADChan_TestPassword (channel, key) != IRC_OK || key == NULL){
+			IRC_Debug("PASS dont match\n");
+			IRC_Reply_ErrBadChannelKey(channel);
+			return FALSE;
+		}
+	}
+
+	switch (IRCTAD_Join (channel, sesion->nick, mode, key)) {
+
+		case IRCERR_NOVALIDUSER: /*no existe el usuario indicado*/
+			IRC_Reply_ErrNoLogin(sesion->user);
+			break;
+
+		case IRCERR_NOVALIDCHANNEL: /*el canal indicado no es valido*/
+			IRC_Reply_ErrNoSuchChannel(channel);
+			break;
+
+		case IRCERR_USERSLIMITEXCEEDED: /*no se admiten mas usuarios en el canal*/
+			IRC_Reply_ErrChannelIsFull(channel);
+			break;
+
+		case IRCERR_NOENOUGHMEMORY: /*no hay suficiente memoria para crear el canal*/
+			break;
+
+		case IRCERR_BANEDUSERONCHANNEL: /*no puede unirse por estar baneado*/
+			IRC_Reply_ErrBannedFromChan(channel);
+			break;
+
+		case IRCERR_NOINVITEDUSER: /*canal con invitacion y no ha sido invitado*/
+			IRC_Reply_ErrInviteOnlyChan(channel);
+			break;
+
+		case IRCERR_YETINCHANNEL: /*user distinto, mismo nick*/
+			break;
+
+		case IRC_OK: /*se ha anadido el usuario al canal*/
+			IRC_Debug("JOIN CORRECTO");
+			*modos = (mode[0] == 'o') ? MIEMBRO_OP : 0;
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*JOIN canal{,canal} [clave{,clave}], o JOIN 0 para salir de todos*/
+static long IRC_Commands_Join(Session *sesion, Mensaje *mensaje)
+{
+	char *lista = PARAM(mensaje, 0), *canales[MAX_CHANELS_USER], *channel, *key = NULL, *resto = NULL, *resto_claves = NULL;
+	char mios[MAX_CHANELS_USER][MAX_CHANNELNAME+1];
+	int modos[MAX_CHANELS_USER], n = 0, i;
+
+	IRC_Debug("CASE JOIN\n");
+
+	if(lista[0] == '0' && lista[1] == '\0'){
+		n = IRC_Channels_Mine(sesion, mios);
+		for(i = 0; i < n; i++)
+			IRC_Commands_Leave(sesion, mios[i]);
+		return FALSE;
+	}
+
+	/*Cada canal toma la clave de su misma posicion, si la hay*/
+	if(PARAM(mensaje, 1) != NULL)
+		key = strtok_r(PARAM(mensaje, 1), ",", &resto_claves);
+
+	for(channel = strtok_r(lista, ",", &resto); channel != NULL; channel = strtok_r(NULL, ",", &resto)){
+		if(sesion->ncanales + n >= MAX_CHANELS_USER)
+			IRC_Reply_ErrTooManyChannels(channel);
+		else if(IRC_Commands_Enter(sesion, channel, key, &modos[n]) == TRUE)
+			canales[n++] = channel;
+
+		if(key != NULL)
+			key = strtok_r(NULL, ",", &resto_claves);
+	}
+
+	/*Todos los aceptados entran en la copia de una vez, y los que no caben se deshacen en el TAD*/
+	IRC_Channels_Join(canales, modos, n, sesion);
+	for(i = 0; i < n; i++){
+		if(modos[i] < 0){
+			IRCTAD_Part(canales[i], sesion->nick);
+			IRC_Reply_ErrTooManyChannels(canales[i]);
+		}
+	}
+
+	return FALSE;
+}
+
+/************************************ LIST ****************************************************/
+/*Añade al filtro una condicion de ELIST, >n o <n miembros y C o T seguidos de >m o <m minutos. FALSE si es una mascara*/
+static long IRC_Commands_Elist(Filtro *filtro, const char *condicion)
+{
+	long *mas = &filtro->mas, *menos = &filtro->menos, escala = 1, n;
+	char *fin;
+
+	if(condicion[0] == 'C' || condicion[0] == 'c'){
+		mas = &filtro->creado_mas;
+		menos = &filtro->creado_menos;
+		escala = 60;
+		condicion++;
+	}else if(condicion[0] == 'T' || condicion[0] == 't'){
+		mas = &filtro->topic_mas;
+		menos = &filtro->topic_menos;
+		escala = 60;
+		condicion++;
+	}
+
+	if(condicion[0] != '>' && condicion[0] != '<')
+		return FALSE;
+
+	/*Una condicion mal escrita se ignora*/
+	n = strtol(condicion + 1, &fin, 10);
+	if(fin == condicion + 1 || *fin != '\0' || n < 0)
+		return TRUE;
+
+	if(condicion[0] == '>')
+		*mas = n * escala;
+	else
+		*menos = n * escala;
+
+	return TRUE;
+}
+
+/*LIST [canal{,canal}], o LIST condicion{,condicion} con las de ELIST y como mucho una mascara, !mascara para los que no la cumplen*/
+static long IRC_Commands_List(Session *sesion, Mensaje *mensaje)
+{
+	Filtro filtro;
+	char *param = PARAM(mensaje, 0), *channel, *resto = NULL;
+	long mascaras = 0;
+
+	IRC_Debug("CASE LIST\n");
+
+	IRC_Reply_ListStart();
+	IRC_Cursor_Filter(&filtro, NULL);
+
+	/*Todos los canales, por partes segun el cliente los vaya leyendo*/
+	if(param == NULL || param[0] == '\0'){
+		IRC_Cursor_Start(sesion, CURSOR_LIST, &filtro);
+		return FALSE;
+	}
+
+	/*Con condiciones o comodines tambien por partes, recorriendo solo los canales que pueden cumplirlas*/
+	if(strpbrk(param, "<>*?") != NULL){
+		for(channel = strtok_r(param, ",", &resto); channel != NULL; channel = strtok_r(NULL, ",", &resto)){
+			if(IRC_Commands_Elist(&filtro, channel) == FALSE){
+				/*El filtro solo tiene una mascara, con mas se rechaza en vez de quedarse con la ultima*/
+				if(++mascaras > 1){
+					IRC_Reply_ErrTooManyTargets(channel);
+					IRC_Reply_ListEnd();
+					return FALSE;
+				}
+				filtro.negada = (channel[0] == '!') ? TRUE : FALSE;
+				IRC_Mask_Compile(&filtro.mascara, channel + (filtro.negada == TRUE ? 1 : 0));
+			}
+		}
+		IRC_Cursor_Start(sesion, CURSOR_LIST, &filtro);
+		return FALSE;
+	}
+
+	for(channel = strtok_r(param, ",", &resto); channel != NULL; channel = strtok_r(NULL, ",", &resto))
+		IRC_Channels_List(channel, sesion);
+
+	IRC_Reply_ListEnd();
+
+	return FALSE;
+}
+
+/************************************ NAMES ***************************************************/
+/*NAMES [canal{,canal}]*/
+static long IRC_Commands_Names(Session *sesion, Mensaje *mensaje)
+{
+	char *channel, *resto = NULL;
+	Filtro filtro;
+
+	IRC_Debug("CASE NAMES\n");
+
+	/*Names de todos los canales del servidor, por partes como LIST*/
+	if(mensaje->nparams < 1 || mensaje->params[0].len == 0){
+		IRC_Cursor_Filter(&filtro, NULL);
+		IRC_Cursor_Start(sesion, CURSOR_NAMES, &filtro);
+		return FALSE;
+	}
+
+	/*Names de cada canal indicado*/
+	for(channel = strtok_r(PARAM(mensaje, 0), ",", &resto); channel != NULL; channel = strtok_r(NULL, ",", &resto)){
+		IRC_Channels_Names(channel, sesion);
+		IRC_Reply_EndOfNames(channel);
+	}
+
+	return FALSE;
+}
+
+/************************************* WHO ****************************************************/
+/*WHO [mascara [o]], un canal o una mascara del nick, user, host o nombre real. Salen por partes segun el cliente los vaya leyendo*/
+static long IRC_Commands_Who(Session *sesion, Mensaje *mensaje)
+{
+	Filtro filtro;
+	char *mask = PARAM(mensaje, 0), *flags = PARAM(mensaje, 1);
+
+	IRC_Debug("CASE WHO\n");
+
+	/*Sin mascara o con 0 son todos los usuarios*/
+	if(mask != NULL && strcmp(mask, "0") == 0)
+		mask = NULL;
+
+	IRC_Cursor_Filter(&filtro, mask);
+	filtro.operadores = (flags != NULL && strchr(flags, 'o') != NULL) ? TRUE : FALSE;
+
+	if(mask != NULL && mask[0] != '\0' && strchr("#&+!", mask[0]) != NULL && strpbrk(mask, "*?") == NULL)
+		IRC_Cursor_Start(sesion, CURSOR_WHO, &filtro);
+	else
+		IRC_Cursor_Start(sesion, CURSOR_USUARIOS, &filtro);
+
+	return FALSE;
+}
+
+/************************************ WHOIS ***************************************************/
+/*WHOIS [servidor] nick{,nick}, todos los nicks con una sola toma del cerrojo de usuarios*/
+static long IRC_Commands_Whois(Session *sesion, Mensaje *mensaje)
+{
+	char *nick, *resto = NULL;
+	Session *objetivo;
+	long ahora = IRC_Timer_Now(), epoca = (long) time(NULL);
+
+	IRC_Debug("CASE WHOIS\n");
+	if(mensaje->nparams < 1 || mensaje->params[mensaje->nparams - 1].len == 0){
+		IRC_Reply_ErrNoNicknameGiven();
+		return FALSE;
+	}
+
+	IRC_Users_ReadLock();
+	for(nick = strtok_r(PARAM(mensaje, mensaje->nparams - 1), ",", &resto); nick != NULL; nick = strtok_r(NULL, ",", &resto)){
+		objetivo = IRC_Users_Find(nick);
+		if(objetivo == NULL || objetivo->estado != SESION_REGISTRADA){
+			IRC_Reply_ErrNoSuchNick(nick);
+		}else{
+			IRC_Reply_WhoisUser(objetivo->nick, objetivo->user, objetivo->host, objetivo->realname);
+			IRC_Channels_Whois(objetivo, sesion);
+			IRC_Reply_WhoisServer(objetivo->nick);
+			if(objetivo->away != NULL)
+				IRC_Reply_Away(objetivo->nick, objetivo->away);
+			/*Los segundos de la sesion son de un reloj monotono, la hora de entrada se pasa a la del sistema*/
+			IRC_Reply_WhoisIdle(objetivo->nick, ahora - objetivo->actividad, epoca - (ahora - objetivo->creada));
+		}
+		IRC_Reply_EndOfWhois(nick);
+	}
+	IRC_Users_Unlock();
+
+	return FALSE;
+}
+
+/************************************ PONG ****************************************************/
+/*Quien lee del socket ya ha anotado la actividad, basta con no responder*/
+static long IRC_Commands_Pong(Session *sesion, Mensaje *mensaje)
+{
+	return FALSE;
+}
+
+/************************************ PING ****************************************************/
+static long IRC_Commands_Ping(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Reply_Line(":%s PONG %s :%s", SERVER, SERVER, PARAM(mensaje, 0));
+
+	return FALSE;
+}
+
+/************************************ PRIVMSG **************************************************/
+/*PRIVMSG y NOTICE: formatea una linea por destino, hasta MAX_TARGETS, y las entrega en una pasada. Sin destino o sin texto responde 411 o 412*/
+static long IRC_Commands_Message(Session *sesion, Mensaje *mensaje, const char *verbo, long avisos)
+{
+	char *destinos[MAX_TARGETS], *destino, *resto = NULL, *lista = PARAM(mensaje, 0), *msg = PARAM(mensaje, 1);
+	Buffer *buffers[MAX_TARGETS];
+	int n = 0, i;
+
+	if(lista == NULL || lista[0] == '\0'){
+		if(avisos == TRUE)
+			IRC_Reply_ErrNoRecipient(verbo);
+		return FALSE;
+	}
+
+	if(msg == NULL || msg[0] == '\0'){
+		if(avisos == TRUE)
+			IRC_Reply_ErrNoTextToSend();
+		return FALSE;
+	}
+
+	for(destino = strtok_r(lista, ",", &resto); destino != NULL; destino = strtok_r(NULL, ",", &resto)){
+		if(n == MAX_TARGETS){
+			if(avisos == TRUE)
+				IRC_Reply_ErrTooManyTargets(destino);
+			continue;
+		}
+		if((buffers[n] = IRC_Reply_Shared("%s %s %s :%s", sesion->prefix, verbo, destino, msg)) != NULL)
+			destinos[n++] = destino;
+	}
+
+	if(n == 0 && avisos == TRUE)
+		IRC_Reply_ErrNoRecipient(verbo);
+
+	IRC_Channels_Deliver(destinos, buffers, n, sesion, avisos);
+
+	for(i = 0; i < n; i++)
+		IRC_Buffer_Unref(buffers[i]);
+
+	return FALSE;
+}
+
+static long IRC_Commands_Privmsg(Session *sesion, Mensaje *mensaje)
+{
+	return IRC_Commands_Message(sesion, mensaje, "PRIVMSG", TRUE);
+}
+
+/************************************ NOTICE ***************************************************/
+static long IRC_Commands_Notice(Session *sesion, Mensaje *mensaje)
+{
+	/*NOTICE nunca provoca respuestas automaticas*/
+	return IRC_Commands_Message(sesion, mensaje, "NOTICE", FALSE);
+}
+
+/************************************ PART ****************************************************/
+/*Sale de un canal en el TAD y en la copia avisando a sus miembros*/
+static void IRC_Commands_Leave(Session *sesion, char *channel)
+{
+	Buffer *buffer = NULL;
+
+	switch (IRCTAD_Part (channel, sesion->nick)) {
+
+		case IRCERR_NOVALIDUSER: /*No existe el usuario en el canal*/
+			IRC_Reply_ErrNotOnChannel(channel);
+			break;
+
+		case IRCERR_NOVALIDCHANNEL: /*No existe el canal indicado*/
+			IRC_Reply_ErrNoSuchChannel(channel);
+			break;
+
+		case IRCERR_UNDELETABLECHANNEL: /*No se puede eliminar el canal porque es permanente*/
+			break;
+
+		case IRC_OK:
+			buffer = IRC_Reply_Shared("%s PART %s :Hasta Nunki", sesion->prefix, channel);
+
+			/*Se avisa antes de sacarle para que el tambien lo reciba*/
+			IRC_Channels_Send(channel, buffer, NULL, TRUE);
+			IRC_Channels_Part(channel, sesion);
+			IRC_Buffer_Unref(buffer);
+
+			break;
+	}
+}
+
+static long IRC_Commands_Part(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Debug("CASE PART\n");
+	IRC_Commands_Leave(sesion, PARAM(mensaje, 0));
+
+	return FALSE;
+}
+
+/************************************ TOPIC ***************************************************/
+static long IRC_Commands_Topic(Session *sesion, Mensaje *mensaje)
+{
+	char *channel = PARAM(mensaje, 0), *topic = PARAM(mensaje, 1);
+	char *topic_actual = NULL;
+
+	IRC_Debug("TOPIC\n");
+
+	/*Comprobamos si el canal tiene topic*/
+	if(IRCTAD_GetTopic (channel, &topic_actual) ==  IRC_OK){
+
+		if(topic == NULL && topic_actual == NULL){
+			IRC_Reply_NoTopic(channel);
+		}else if (topic == NULL && topic_actual != NULL){
+			IRC_Reply_Topic(channel, topic_actual);
+		}else{
+			/*Primero comprobamos el modo que tiene el canal*/
+			if((IRCTADChan_GetModeInt (channel) & IRCMODE_TOPICOP) == IRCMODE_TOPICOP){
+				IRC_Reply_ErrChanOPrivsNeeded(channel);
+			}else{
+				if(IRCTAD_SetTopic (channel, sesion->nick, topic) == IRC_OK){
+					IRC_Channels_SetTopic(channel, topic, sesion->nick);
+					IRC_Reply_Line("%s TOPIC %s :%s", sesion->prefix, channel, topic);
+				}
+			}
+		}
+		free(topic_actual);
+	}
+
+	return FALSE;
+}
+
+/************************************ MODE ****************************************************/
+static long IRC_Commands_Mode(Session *sesion, Mensaje *mensaje)
+{
+	char *channel = PARAM(mensaje, 0), *modo = PARAM(mensaje, 1), *user = PARAM(mensaje, 2);
+	char setpass[MAX_BUFFER];
+	Session *miembro;
+	long modos;
+
+	IRC_Debug("CASE MODE\n");
+
+	if((IRCTAD_GetUserModeOnChannel (channel, sesion->nick) & IRCUMODE_OPERATOR) != IRCUMODE_OPERATOR){
+		IRC_Reply_ErrChanOPrivsNeeded(channel);
+	}else{
+		if(modo != NULL){
+			if(strcmp(modo, "\\+k") == 0 && user != NULL){
+				snprintf(setpass, sizeof(setpass), "+k %s", user);
+
+				if(IRCTAD_Mode (channel, sesion->nick, setpass) == IRC_OK){
+					IRC_Channels_SetMode(channel, IRCTADChan_GetModeInt(channel));
+					IRC_Reply_Line("%s MODE %s %s", sesion->prefix, channel, setpass);
+				}
+			}else if(IRCTAD_Mode (channel, sesion->nick, modo) == IRC_OK){
+				IRC_Channels_SetMode(channel, IRCTADChan_GetModeInt(channel));
+				IRC_Reply_Line("%s MODE %s %s%s%s", sesion->prefix, channel, modo,
+					user != NULL ? " " : "", user != NULL ? user : "");
+
+				/*Los '@' y '+' de NAMES y WHOIS se copian de lo que ha quedado en el TAD*/
+				if(user != NULL){
+					modos = IRCTAD_GetUserModeOnChannel(channel, user);
+					IRC_Users_ReadLock();
+					if((miembro = IRC_Users_Find(user)) != NULL)
+						IRC_Channels_SetModes(channel, miembro, ((modos & IRCUMODE_OPERATOR) ? MIEMBRO_OP : 0) |
+							((modos & IRCUMODE_VOICE) ? MIEMBRO_VOZ : 0));
+					IRC_Users_Unlock();
+				}
+			}
+		}
+	}
+
+	return FALSE;
+}
+
+/************************************ KICK ****************************************************/
+static long IRC_Commands_Kick(Session *sesion, Mensaje *mensaje)
+{
+	char *channel = PARAM(mensaje, 0), *user = PARAM(mensaje, 1), *comment = PARAM(mensaje, 2);
+	Buffer *buffer = NULL;
+	Session *miembro;
+
+	IRC_Debug("CASE KICK\n");
+
+	if((IRCTAD_GetUserModeOnChannel (channel, sesion->nick) & IRCUMODE_OPERATOR) != IRCUMODE_OPERATOR){
+		IRC_Reply_ErrChanOPrivsNeeded(channel);
+	}else{
+		switch (IRCTAD_KickUserFromChannel (channel, user)) {
+			case IRCERR_NOVALIDUSER:
+				IRC_Reply_ErrUserNotInChannel(user, channel);
+				break;
+
+			case IRCERR_NOVALIDCHANNEL:  /*el canal indicado no es valido*/
+				IRC_Reply_ErrNoSuchChannel(channel);
+				break;
+
+			case IRCERR_UNDELETABLECHANNEL:
+				break;
+
+			case IRC_OK:
+				buffer = IRC_Reply_Shared("%s KICK %s %s :%s", sesion->prefix, channel, user,
+					comment != NULL ? comment : user);
+
+				/*Notificacamos a todos los usuarios del canal, incluido el expulsado, antes de sacarle*/
+				IRC_Channels_Send(channel, buffer, NULL, TRUE);
+				IRC_Buffer_Unref(buffer);
+
+				IRC_Users_ReadLock();
+				if((miembro = IRC_Users_Find(user)) != NULL)
+					IRC_Channels_Part(channel, miembro);
+				IRC_Users_Unlock();
+				break;
+		}
+	}
+
+	return FALSE;
+}
+
+/************************************ AWAY ****************************************************/
+static long IRC_Commands_Away(Session *sesion, Mensaje *mensaje)
+{
+	char *comment = mensaje->nparams > 0 && mensaje->params[0].len > 0 ? PARAM(mensaje, 0) : NULL;
+
+	IRC_Debug("CASE AWAY");
+	if(IRCTADUser_SetAway (0, NULL, sesion->nick, NULL, comment) == IRC_OK){
+		IRC_Users_SetAway(sesion, comment);
+		if(comment != NULL)
+			IRC_Reply_NowAway();
+		else
+			IRC_Reply_Unaway();
+	}
+
+	return FALSE;
+}
+
+/************************************ QUIT ****************************************************/
+static long IRC_Commands_Quit(Session *sesion, Mensaje *mensaje)
+{
+	Buffer *buffer;
+
+	IRC_Debug("CASE QUIT\n");
+
+	/*Si estaba registrado se le confirma la salida y se avisa con su motivo a quienes estan con el, la baja la hace IRC_Session_Free*/
+	if(sesion->estado == SESION_REGISTRADA){
+		IRC_Reply_Line("%s QUIT :%s", sesion->prefix, mensaje->nparams > 0 ? PARAM(mensaje, 0) : sesion->nick);
+		buffer = IRC_Reply_Shared("%s QUIT :%s", sesion->prefix, mensaje->nparams > 0 ? PARAM(mensaje, 0) : sesion->nick);
+		IRC_Channels_Quit(sesion, buffer);
+		IRC_Buffer_Unref(buffer);
+	}
+
+	return TRUE;
+}
+
+/************************************ MOTD ****************************************************/
+static long IRC_Commands_Motd(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Debug("MOTD\n");
+
+	IRC_Welcome_Motd(sesion);
+
+	return FALSE;
+}
+
+/************************************ REHASH **************************************************/
+/*No hay operadores de servidor, asi que solo se acepta desde la propia maquina*/
+static long IRC_Commands_Rehash(Session *sesion, Mensaje *mensaje)
+{
+	if((ntohl(sesion->direccion.s_addr) >> 24) != 127){
+		IRC_Reply_ErrNoPrivileges();
+		return FALSE;
+	}
+
+	IRC_Reply_Rehashing(IRC_Welcome_Path());
+	IRC_Welcome_Load();
+
+	return FALSE;
+}
+
+/************************************ LUSERS **************************************************/
+static long IRC_Commands_Lusers(Session *sesion, Mensaje *mensaje)
+{
+	IRC_Stats_Lusers();
+
+	return FALSE;
+}
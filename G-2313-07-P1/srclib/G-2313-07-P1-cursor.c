@@ -0,0 +1,264 @@
+/**
+* @brief Cursores que generan por partes las respuestas largas
+* @file G-2313-07-P1-cursor.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-cursor.h"
+#include "../includes/G-2313-07-P1-session.h"
+#include "../includes/G-2313-07-P1-channels.h"
+#include "../includes/G-2313-07-P1-reply.h"
+
+/*! @page irc_cursor Respuestas largas
+*
+* <p>Esta sección incluye los cursores con los que se generan LIST, WHO y NAMES sin canales.
+* El manejador abre un cursor en la sesion, que guarda por donde va, y genera solo
+* CURSOR_CUOTA bytes, asi una respuesta de cien mil lineas no ocupa al reactor de golpe ni
+* llena la cola de salida de quien la pide. El reactor, cada vez que consigue vaciar la cola de esa sesion, le pide la
+* siguiente cuota con IRC_Cursor_Step, y lo hace en la siguiente vuelta del bucle para atender
+* antes al resto de conexiones. Si el socket no admite mas se espera al EPOLLOUT, asi la
+* respuesta avanza al ritmo al que el cliente la lee. En el modelo de hilos el hilo del cliente
+* pide las cuotas seguidas y send le frena.<br>
+* Los canales o miembros que se crean o se van mientras el cursor esta a medias pueden salir o no,
+* igual que en cualquier servidor que responde LIST por partes.</p>
+*
+* <p>El cursor guarda tambien el filtro del LIST: numero de miembros, minutos desde que se creo el
+* canal o se puso el topic y una mascara del nombre, ver @ref irc_mask. Los canales que no lo
+* cumplen no cuentan para la cuota de bytes, pero si para la de canales revisados, asi que un
+* filtro que casi nada cumple tampoco ocupa al reactor.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-cursor.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Cursor_Filter</li>
+* <li>@subpage IRC_Cursor_Start</li>
+* <li>@subpage IRC_Cursor_Step</li>
+* <li>@subpage IRC_Cursor_Active</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+/*Genera una cuota del cursor y la respuesta final si termina. Hay que tener la respuesta abierta*/
+static void IRC_Cursor_Run(Session *sesion)
+{
+	Cursor *cursor = &sesion->cursor;
+	long terminado = TRUE;
+
+	switch(cursor->tipo){
+		case CURSOR_LIST:
+			if((terminado = IRC_Channels_ListFrom(&cursor->filtro, sesion, CURSOR_CUOTA)) == TRUE)
+				IRC_Reply_ListEnd();
+			break;
+
+		case CURSOR_WHO:
+			if((terminado = IRC_Channels_WhoFrom(&cursor->filtro, &cursor->posicion, sesion, CURSOR_CUOTA)) == TRUE)
+				IRC_Reply_EndOfWho(cursor->filtro.mascara.patron);
+			break;
+
+		case CURSOR_USUARIOS:
+			if((terminado = IRC_Channels_WhoMatch(&cursor->filtro, sesion, CURSOR_CUOTA)) == TRUE)
+				IRC_Reply_EndOfWho(cursor->filtro.mascara.patron[0] != '\0' ? cursor->filtro.mascara.patron : "*");
+			break;
+
+		case CURSOR_NAMES:
+			if((terminado = IRC_Channels_NamesFrom(&cursor->filtro, sesion, CURSOR_CUOTA)) == TRUE)
+				IRC_Reply_EndOfNames("*");
+			break;
+	}
+
+	if(terminado == TRUE)
+		cursor->tipo = CURSOR_NINGUNO;
+}
+
+/**
+ * @page IRC_Cursor_Filter IRC_Cursor_Filter
+ * @brief Deja un filtro sin condiciones
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-cursor.h"
+ *
+ * void IRC_Cursor_Filter(Filtro *filtro, const char *mascara)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Prepara la mascara y deja el resto de condiciones a FILTRO_NADA. El manejador de LIST añade
+ * despues las condiciones que pida el cliente, y WHO la mascara y si solo quiere operadores.
+ *
+ * @param[out] filtro filtro que se rellena
+ * @param[in] mascara mascara del nombre, NULL para cualquiera
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Cursor_Filter(Filtro *filtro, const char *mascara)
+{
+	IRC_Mask_Compile(&filtro->mascara, mascara);
+	filtro->negada = FALSE;
+	filtro->operadores = FALSE;
+	filtro->mas = filtro->menos = FILTRO_NADA;
+	filtro->creado_mas = filtro->creado_menos = FILTRO_NADA;
+	filtro->topic_mas = filtro->topic_menos = FILTRO_NADA;
+	filtro->indice = FILTRO_NINGUNO;
+	filtro->campo = 0;
+	filtro->ultimo[0] = '\0';
+	filtro->nick[0] = '\0';
+}
+
+/**
+ * @page IRC_Cursor_Start IRC_Cursor_Start
+ * @brief Empieza una respuesta larga y genera su primera cuota
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-cursor.h"
+ *
+ * void IRC_Cursor_Start(Session *sesion, int tipo, const Filtro *filtro)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La llaman los manejadores de LIST, WHO y NAMES despues de su primera linea. Si la sesion ya
+ * tenia otra respuesta a medias se termina con su respuesta final, para que el cliente no se quede
+ * esperandola. La primera cuota sale junto con el resto de la respuesta del comando y la
+ * respuesta final, RPL_LISTEND, RPL_ENDOFWHO o RPL_ENDOFNAMES, la añade el cursor al terminar.
+ *
+ * @param[in,out] sesion cliente que la pide, con la respuesta abierta con IRC_Reply_Begin
+ * @param[in] tipo CURSOR_LIST, CURSOR_WHO, CURSOR_USUARIOS o CURSOR_NAMES
+ * @param[in] filtro canales del LIST, o canal o usuarios del WHO, sin condiciones en NAMES
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Cursor_Start(Session *sesion, int tipo, const Filtro *filtro)
+{
+	Cursor *cursor = &sesion->cursor;
+
+	if(cursor->tipo == CURSOR_LIST)
+		IRC_Reply_ListEnd();
+	else if(cursor->tipo == CURSOR_WHO || cursor->tipo == CURSOR_USUARIOS)
+		IRC_Reply_EndOfWho(cursor->filtro.mascara.patron[0] != '\0' ? cursor->filtro.mascara.patron : "*");
+	else if(cursor->tipo == CURSOR_NAMES)
+		IRC_Reply_EndOfNames("*");
+
+	cursor->tipo = tipo;
+	cursor->posicion = 0;
+	cursor->filtro = *filtro;
+
+	IRC_Cursor_Run(sesion);
+}
+
+/**
+ * @page IRC_Cursor_Step IRC_Cursor_Step
+ * @brief Genera la siguiente cuota de la respuesta a medias de una sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-cursor.h"
+ *
+ * long IRC_Cursor_Step(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Genera hasta CURSOR_CUOTA bytes mas de la respuesta y los encola en un solo buffer. La llama el
+ * reactor cuando la cola de la sesion se queda vacia, y el hilo del cliente en el modelo de
+ * hilos hasta que devuelve FALSE.
+ *
+ * Una cuota puede no generar nada, si revisa CURSOR_CUOTA canales o usuarios sin que ninguno
+ * cumpla el filtro del LIST o la mascara del WHO. Por eso el reactor vuelve a apuntar la sesion
+ * siempre que devuelve TRUE, y no espera a que se encole algo.
+ *
+ * @param[in,out] sesion cliente
+ *
+ * @retval TRUE si aun queda respuesta
+ * @retval FALSE si ha terminado o no habia ninguna
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Cursor_Step(Session *sesion)
+{
+	if(sesion->cursor.tipo == CURSOR_NINGUNO)
+		return FALSE;
+
+	IRC_Reply_Begin(sesion);
+	IRC_Cursor_Run(sesion);
+	IRC_Reply_End();
+
+	return IRC_Cursor_Active(sesion);
+}
+
+/**
+ * @page IRC_Cursor_Active IRC_Cursor_Active
+ * @brief Indica si la sesion tiene una respuesta a medias
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-cursor.h"
+ *
+ * long IRC_Cursor_Active(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * El reactor la consulta al vaciar la cola de la sesion para saber si tiene que pedir mas.
+ *
+ * @param[in] sesion cliente
+ *
+ * @retval TRUE si hay un cursor abierto
+ * @retval FALSE si no
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Cursor_Active(Session *sesion)
+{
+	return (sesion->cursor.tipo != CURSOR_NINGUNO) ? TRUE : FALSE;
+}
@@ -0,0 +1,220 @@
+/**
+* @brief Separador de lineas IRC sobre un buffer circular por conexion
+* @file G-2313-07-P1-framer.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-framer.h"
+
+/*! @page irc_framer Separador de lineas
+*
+* <p>Esta sección incluye el buffer de entrada de cada conexion. Lo recibido se guarda en un
+* buffer circular y se entregan las lineas completas, terminadas en CRLF o solo LF, aunque
+* hayan llegado partidas en varios segmentos TCP.<br>
+* Las lineas se entregan en el propio buffer, sustituyendo el fin de linea por '\\0', sin
+* copiarlas. Solo se copian las que dan la vuelta al final del buffer.<br>
+* Las lineas de mas de MAX_BUFFER bytes, contando el fin de linea, se descartan enteras.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-framer.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Framer_Init</li>
+* <li>@subpage IRC_Framer_Read</li>
+* <li>@subpage IRC_Framer_Next</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+#define POS(p) ((p) & (FRAMER_SIZE - 1)) /*!<Posicion dentro del buffer circular*/
+
+/**
+ * @page IRC_Framer_Init IRC_Framer_Init
+ * @brief Deja el buffer de entrada vacio
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-framer.h"
+ *
+ * void IRC_Framer_Init(Framer *framer)
+ * @endcode
+ *
+ * @param[in,out] framer buffer que se inicializa
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Framer_Init(Framer *framer)
+{
+	framer->inicio = framer->fin = framer->revisado = 0;
+	framer->descartando = 0;
+}
+
+/**
+ * @page IRC_Framer_Read IRC_Framer_Read
+ * @brief Recibe del socket en el hueco libre del buffer circular
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-framer.h"
+ *
+ * ssize_t IRC_Framer_Read(Framer *framer, int desc, int flags)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Hace un unico recvmsg sobre los dos tramos libres del buffer circular, de forma que
+ * nunca hace falta mover lo que ya habia ni poner a cero el buffer antes de recibir.
+ *
+ * @param[in,out] framer buffer de la conexion
+ * @param[in] desc descriptor del socket
+ * @param[in] flags flags de recvmsg, MSG_DONTWAIT en los reactores
+ *
+ * @retval ssize_t bytes recibidos, 0 si el cliente ha cerrado o -1 en caso de error con errno
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+ssize_t IRC_Framer_Read(Framer *framer, int desc, int flags)
+{
+	struct iovec tramos[2];
+	struct msghdr mensaje;
+	size_t libre, hasta_final;
+	ssize_t leidos;
+
+	libre = FRAMER_SIZE - (framer->fin - framer->inicio);
+	hasta_final = FRAMER_SIZE - POS(framer->fin);
+
+	tramos[0].iov_base = &framer->datos[POS(framer->fin)];
+	if(libre <= hasta_final){
+		tramos[0].iov_len = libre;
+		tramos[1].iov_len = 0;
+	}else{
+		tramos[0].iov_len = hasta_final;
+		tramos[1].iov_len = libre - hasta_final;
+	}
+	tramos[1].iov_base = framer->datos;
+
+	memset(&mensaje, 0, sizeof(mensaje));
+	mensaje.msg_iov = tramos;
+	mensaje.msg_iovlen = (tramos[1].iov_len > 0) ? 2 : 1;
+
+	leidos = recvmsg(desc, &mensaje, flags);
+	if(leidos > 0)
+		framer->fin += leidos;
+
+	return leidos;
+}
+
+/**
+ * @page IRC_Framer_Next IRC_Framer_Next
+ * @brief Devuelve la siguiente linea completa del buffer
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-framer.h"
+ *
+ * char *IRC_Framer_Next(Framer *framer)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Busca el siguiente LF a partir de donde se quedo la ultima busqueda, de forma que cada byte
+ * recibido se revisa una sola vez. El LF y el CR que le precede se sustituyen por '\\0' y se
+ * devuelve un puntero al inicio de la linea dentro del propio buffer.
+ *
+ * Las lineas vacias se saltan. Si una linea pasa de MAX_BUFFER bytes sin fin de linea se
+ * descarta hasta su LF.
+ *
+ * @param[in,out] framer buffer de la conexion
+ *
+ * @retval char* la linea, valida hasta la siguiente llamada a IRC_Framer_Read
+ * @retval NULL si no hay ninguna linea completa
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+char *IRC_Framer_Next(Framer *framer)
+{
+	size_t p, len, tramo;
+	char *linea;
+
+	while(1){
+		for(p = framer->revisado; p < framer->fin; p++){
+			if(framer->datos[POS(p)] == '\n')
+				break;
+		}
+
+		if(p == framer->fin){
+			framer->revisado = p;
+			if(framer->fin - framer->inicio >= MAX_BUFFER){
+				IRC_Log(LOG_INFO, "Line too long, discarding");
+				framer->descartando = 1;
+				framer->inicio = framer->revisado = framer->fin;
+			}
+			return NULL;
+		}
+
+		len = p - framer->inicio;
+		if(framer->descartando || len + 1 > MAX_BUFFER || len == 0 ||
+		  (len == 1 && framer->datos[POS(framer->inicio)] == '\r')){
+			framer->descartando = 0;
+			framer->inicio = framer->revisado = p + 1;
+			continue;
+		}
+
+		framer->datos[POS(p)] = '\0';
+		if(framer->datos[POS(p - 1)] == '\r')
+			framer->datos[POS(p - 1)] = '\0';
+
+		if(POS(framer->inicio) <= POS(p)){
+			linea = &framer->datos[POS(framer->inicio)];
+		}else{
+			/*La linea da la vuelta al buffer, se junta en la copia*/
+			tramo = FRAMER_SIZE - POS(framer->inicio);
+			memcpy(framer->linea, &framer->datos[POS(framer->inicio)], tramo);
+			memcpy(framer->linea + tramo, framer->datos, len - tramo + 1);
+			linea = framer->linea;
+		}
+
+		framer->inicio = framer->revisado = p + 1;
+		return linea;
+	}
+}
@@ -0,0 +1,168 @@
+/**
+* @brief Mascaras con comodines de LIST y WHO
+* @file G-2313-07-P1-mask.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-mask.h"
+#include "../includes/G-2313-07-P1-users.h"
+
+/*! @page irc_mask Mascaras
+*
+* <p>Esta sección incluye las mascaras con las que LIST filtra los canales por su nombre y WHO
+* los usuarios por su nick, user, host o nombre real. Una mascara admite '*' para cualquier
+* cadena y '?' para cualquier caracter, y no distingue mayusculas segun el RFC 1459, con
+* IRC_Users_Fold, igual que los indices ordenados en los que se busca su prefijo.</p>
+*
+* <p>La mascara se prepara una vez al recibir el comando y despues se compara con cada nombre.
+* Al prepararla se cuentan los caracteres fijos del principio, de modo que quien tenga los
+* nombres ordenados puede buscar ese prefijo y recorrer solo los que empiezan por el, y se
+* apunta si no tiene comodines, en cuyo caso basta una comparacion. La comparacion con comodines
+* vuelve solo al ultimo '*', asi que nunca es exponencial.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-mask.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Mask_Compile</li>
+* <li>@subpage IRC_Mask_Match</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+/**
+ * @page IRC_Mask_Compile IRC_Mask_Compile
+ * @brief Prepara una mascara
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-mask.h"
+ *
+ * void IRC_Mask_Compile(Mascara *mascara, const char *patron)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia el patron, recortandolo a MASK_MAX caracteres, y cuenta los caracteres fijos que hay
+ * antes del primer comodin. Los '*' seguidos se dejan en uno.
+ *
+ * @param[out] mascara mascara que se rellena
+ * @param[in] patron texto de la mascara, NULL o vacio para cualquier nombre
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Mask_Compile(Mascara *mascara, const char *patron)
+{
+	int i = 0;
+
+	mascara->prefijo = -1;
+	mascara->comodines = FALSE;
+
+	for(; patron != NULL && *patron != '\0' && i < MASK_MAX; patron++){
+		if(*patron == '*' && i > 0 && mascara->patron[i-1] == '*')
+			continue;
+		if(*patron == '*' || *patron == '?'){
+			if(mascara->comodines == FALSE)
+				mascara->prefijo = i;
+			mascara->comodines = TRUE;
+		}
+		mascara->patron[i++] = *patron;
+	}
+	mascara->patron[i] = '\0';
+
+	if(mascara->comodines == FALSE)
+		mascara->prefijo = i;
+}
+
+/**
+ * @page IRC_Mask_Match IRC_Mask_Match
+ * @brief Compara un nombre con una mascara
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-mask.h"
+ *
+ * long IRC_Mask_Match(const Mascara *mascara, const char *nombre)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Descarta primero los nombres que no empiezan por el prefijo fijo. Si la mascara no tiene
+ * comodines compara el resto del nombre, y si los tiene avanza por los dos a la vez volviendo al
+ * ultimo '*' cuando algo no coincide. No distingue mayusculas segun el RFC 1459, asi que
+ * "[a]*" cumple "{A}b".
+ *
+ * @param[in] mascara mascara preparada con IRC_Mask_Compile
+ * @param[in] nombre nombre que se compara
+ *
+ * @retval TRUE si el nombre cumple la mascara o la mascara esta vacia
+ * @retval FALSE si no
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Mask_Match(const Mascara *mascara, const char *nombre)
+{
+	const char *p, *estrella = NULL, *vuelta = NULL;
+
+	if(mascara->patron[0] == '\0')
+		return TRUE;
+	if(IRC_Users_Compare(mascara->patron, nombre, mascara->prefijo) != 0)
+		return FALSE;
+	if(mascara->comodines == FALSE)
+		return (nombre[mascara->prefijo] == '\0') ? TRUE : FALSE;
+
+	p = mascara->patron + mascara->prefijo;
+	nombre += mascara->prefijo;
+
+	while(*nombre != '\0'){
+		if(*p == '*'){
+			estrella = ++p;
+			vuelta = nombre;
+		}else if(*p == '?' || (*p != '\0' && IRC_Users_Fold(*p) == IRC_Users_Fold(*nombre))){
+			p++;
+			nombre++;
+		}else if(estrella != NULL){
+			p = estrella;
+			nombre = ++vuelta;
+		}else{
+			return FALSE;
+		}
+	}
+
+	while(*p == '*')
+		p++;
+
+	return (*p == '\0') ? TRUE : FALSE;
+}
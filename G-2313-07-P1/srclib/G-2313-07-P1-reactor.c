@@ -0,0 +1,700 @@
+/**
+* @brief Bucle de eventos basado en epoll para atender a los clientes
+* @file G-2313-07-P1-reactor.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-resolver.h"
+#include "../includes/G-2313-07-P1-cursor.h"
+
+/*! @page irc_reactor Bucle de eventos
+*
+* <p>Esta sección incluye los bucles de eventos que sustituyen al modelo de un hilo por cliente.
+* Se lanzan varios reactores, por defecto uno por nucleo. Cada uno tiene su propio socket de
+* escucha abierto con SO_REUSEPORT, de forma que el kernel reparte las conexiones entre ellos,
+* su propio epoll en modo edge-triggered y sus propias conexiones, y llama a IRC_Server_Parser
+* con los comandos completos que van llegando.<br>
+* Los mensajes para un cliente de otro reactor se dejan en el buzon de ese reactor y se le
+* despierta con un eventfd, asi cada conexion solo la toca el hilo que la atiende.<br>
+* Nada se envia en el momento: los mensajes van a la cola de salida de cada conexion y al
+* final de cada vuelta del bucle se vacian con un writev por conexion (@ref irc_sendq).<br>
+* epoll_wait despierta como mucho cada segundo para avanzar la rueda de temporizadores
+* (@ref irc_timer), que manda PING a los inactivos y cierra a los que no contestan o no se
+* registran a tiempo.<br>
+* Los hilos del resolvedor (@ref irc_resolver) tambien usan el buzon para avisar de que el
+* host de una conexion ya esta resuelto y se puede terminar su registro.<br>
+* El modelo de hilos sigue disponible en IRC_Accept_Connection para poder comparar ambos.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-reactor.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Reactor_Run</li>
+* <li>@subpage IRC_Reactor_Send</li>
+* <li>@subpage IRC_Reactor_SendBuffer</li>
+* <li>@subpage IRC_Reactor_Notify</li>
+* <li>@subpage IRC_Reactor_Wake</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+
+static Reactor reactores[MAX_REACTORS];                   /**< @brief Reactores lanzados */
+static Reactor * volatile propietarios[MAX_DESCRIPTORS];  /**< @brief Reactor que atiende cada descriptor */
+static Session *sesiones[MAX_DESCRIPTORS];                /**< @brief Sesion de cada descriptor, solo la lee su reactor */
+static _Thread_local Reactor *reactor_actual = NULL;      /**< @brief Reactor del hilo en curso */
+static int lanzados = 0;                                  /**< @brief Reactores con su eventfd creado */
+
+
+/**
+* @brief Apunta la sesion para que se envie su cola al final de la vuelta
+*
+* @param reactor reactor que atiende la sesion
+* @param sesion sesion con algo que enviar o que cerrar
+*/
+static void IRC_Reactor_Pending(Reactor *reactor, Session *sesion)
+{
+	if(sesion->pendiente == TRUE)
+		return;
+	sesion->pendiente = TRUE;
+	sesion->sig_pendiente = reactor->pendientes;
+	reactor->pendientes = sesion;
+}
+
+/**
+* @brief Encola un mensaje para una conexion de este reactor
+*
+* Si el cliente ya tiene en cola mas de lo permitido se le marca para cerrar.
+*
+* @param reactor reactor que atiende el descriptor
+* @param desc descriptor destino
+* @param buffer mensaje a enviar, la cola toma su propia referencia
+*/
+static void IRC_Reactor_Write(Reactor *reactor, int desc, Buffer *buffer)
+{
+	Session *sesion = sesiones[desc];
+
+	if(sesion == NULL || sesion->cerrar == TRUE)
+		return;
+
+	if(IRC_SendQ_PushBuffer(&sesion->salida, buffer) == FALSE){
+		IRC_Log(LOG_INFO, "SendQ exceeded on %d, closing", desc);
+		sesion->cerrar = TRUE;
+	}
+	IRC_Reactor_Pending(reactor, sesion);
+}
+
+/**
+* @brief Deja una entrega en el buzon de otro reactor y le despierta
+*
+* @param destino reactor que atiende el descriptor
+* @param desc descriptor destino
+* @param id sesion destino, para descartar la entrega si el descriptor ya es de otra sesion
+* @param buffer referencia al mensaje que pasa al buzon, NULL para un aviso del resolvedor
+*/
+static void IRC_Reactor_Post(Reactor *destino, int desc, long id, Buffer *buffer)
+{
+	Entrega *entrega;
+	uint64_t uno = 1;
+
+	if((entrega = (Entrega *) malloc(sizeof(Entrega))) == NULL){
+		IRC_Buffer_Unref(buffer);
+		return;
+	}
+	entrega->desc = desc;
+	entrega->id = id;
+	entrega->buffer = buffer;
+	entrega->sig = NULL;
+
+	pthread_mutex_lock(&destino->mutex);
+	if(destino->ultima == NULL)
+		destino->buzon = entrega;
+	else
+		destino->ultima->sig = entrega;
+	destino->ultima = entrega;
+	pthread_mutex_unlock(&destino->mutex);
+
+	if(write(destino->avisos, &uno, sizeof(uno)) < 0)
+		IRC_Log(LOG_ERR, "Error waking reactor %d", destino->id);
+}
+
+/**
+* @brief Termina el registro aplazado de una sesion cuyo host ya esta resuelto
+*
+* Termina el registro y vuelve a programar el temporizador, que mientras se esperaba al
+* DNS vencia al acabar el plazo del resolvedor.
+*
+* @param reactor reactor que atiende la sesion
+* @param sesion sesion con el registro aplazado
+*/
+static void IRC_Reactor_Resume(Reactor *reactor, Session *sesion)
+{
+	long vence;
+
+	if(sesion->cerrar == TRUE || sesion->estado != SESION_ESPERA)
+		return;
+
+	IRC_Server_Resume(sesion);
+	if((vence = IRC_Ping_Pong(sesion, IRC_Timer_Now())) < 0)
+		sesion->cerrar = TRUE;
+	else
+		IRC_Timer_Add(&reactor->rueda, &sesion->temporizador, vence);
+	IRC_Reactor_Pending(reactor, sesion);
+}
+
+/**
+* @brief Entrega los mensajes que otros reactores han dejado en el buzon
+*
+* Solo se entregan los mensajes y los avisos del resolvedor cuya sesion sigue siendo la que
+* atiende el descriptor en este reactor. Si la conexion se ha cerrado entre medias se descartan,
+* aunque el kernel ya haya dado el mismo descriptor a otra conexion.
+*
+* @param reactor reactor que vacia su buzon
+*/
+static void IRC_Reactor_Mailbox(Reactor *reactor)
+{
+	uint64_t avisos;
+	Entrega *entrega, *sig;
+	Session *sesion;
+
+	if(read(reactor->avisos, &avisos, sizeof(avisos)) < 0 && errno != EAGAIN)
+		IRC_Log(LOG_ERR, "Error reading eventfd of reactor %d", reactor->id);
+
+	pthread_mutex_lock(&reactor->mutex);
+	entrega = reactor->buzon;
+	reactor->buzon = reactor->ultima = NULL;
+	pthread_mutex_unlock(&reactor->mutex);
+
+	while(entrega != NULL){
+		sig = entrega->sig;
+		sesion = sesiones[entrega->desc];
+		if(propietarios[entrega->desc] != reactor || sesion == NULL || sesion->id != entrega->id)
+			sesion = NULL;
+		if(entrega->buffer == NULL){
+			if(sesion != NULL)
+				IRC_Reactor_Resume(reactor, sesion);
+		}else{
+			if(sesion != NULL)
+				IRC_Reactor_Write(reactor, entrega->desc, entrega->buffer);
+			IRC_Buffer_Unref(entrega->buffer);
+		}
+		free(entrega);
+		entrega = sig;
+	}
+}
+
+/**
+* @brief Acepta todas las conexiones pendientes y las registra en epoll
+*
+* Con edge-triggered solo se avisa una vez, por lo que se acepta hasta que accept
+* devuelve EAGAIN.
+*
+* @param reactor reactor que acepta las conexiones
+*/
+static void IRC_Reactor_Accept(Reactor *reactor)
+{
+	int desc;
+	struct epoll_event ev;
+	Session *sesion;
+
+	while(1){
+		if((desc = accept(reactor->sockval, NULL, NULL)) < 0){
+			if(errno == EINTR)
+				continue;
+			if(errno != EAGAIN && errno != EWOULDBLOCK)
+				IRC_Log(LOG_ERR, "Error accepting connection");
+			return;
+		}
+		IRC_Debug("%d descriptor de usuario en reactor %d\n", desc, reactor->id);
+
+		if(desc >= MAX_DESCRIPTORS || (sesion = IRC_Session_New(desc)) == NULL){
+			close(desc);
+			continue;
+		}
+		fcntl(desc, F_SETFL, fcntl(desc, F_GETFL, 0) | O_NONBLOCK);
+
+		ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+		ev.data.ptr = sesion;
+		if(epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, desc, &ev) < 0){
+			IRC_Log(LOG_ERR, "Error adding %d to epoll", desc);
+			IRC_Session_Free(sesion);
+			continue;
+		}
+		sesiones[desc] = sesion;
+		propietarios[desc] = reactor;
+		IRC_Timer_Add(&reactor->rueda, &sesion->temporizador, IRC_Ping_Pong(sesion, sesion->creada));
+	}
+}
+
+/**
+* @brief Cierra una conexion del reactor
+*
+* Antes de cerrar se intenta enviar lo que quede en la cola, por ejemplo la respuesta a QUIT.
+*
+* @param reactor reactor que atiende la conexion
+* @param sesion sesion que se cierra
+*/
+static void IRC_Reactor_Close(Reactor *reactor, Session *sesion)
+{
+	IRC_SendQ_Flush(&sesion->salida, sesion->desc);
+	IRC_Timer_Del(&sesion->temporizador);
+	epoll_ctl(reactor->epfd, EPOLL_CTL_DEL, sesion->desc, NULL);
+	sesiones[sesion->desc] = NULL;
+	propietarios[sesion->desc] = NULL;
+	IRC_Session_Free(sesion);
+}
+
+/**
+* @brief Envia las colas de las sesiones apuntadas en esta vuelta y cierra las marcadas
+*
+* Asi todo lo que se genera para una conexion en una vuelta del bucle sale en un solo writev.
+* Si el socket no admite mas, el resto se envia cuando epoll avise con EPOLLOUT.
+*
+* Si una sesion con un LIST o WHO a medias ha vaciado su cola se genera la siguiente cuota, que
+* se envia en la siguiente vuelta, despues de atender al resto. Por eso se recorre la lista que
+* habia al empezar y no la que se va formando. Mientras el cursor siga abierto la sesion se vuelve
+* a apuntar aunque la cuota no haya escrito nada, porque con un filtro que descarta todo lo
+* revisado no se encola ningun mensaje que lo haga.
+*
+* @param reactor reactor que vacia sus colas
+*/
+static void IRC_Reactor_Flush(Reactor *reactor)
+{
+	Session *sesion, *lista = reactor->pendientes;
+	int estado;
+
+	reactor->pendientes = NULL;
+
+	while((sesion = lista) != NULL){
+		lista = sesion->sig_pendiente;
+		sesion->pendiente = FALSE;
+		sesion->sig_pendiente = NULL;
+
+		if(sesion->cerrar == TRUE || (estado = IRC_SendQ_Flush(&sesion->salida, sesion->desc)) == SENDQ_ERROR)
+			IRC_Reactor_Close(reactor, sesion);
+		else if(estado == SENDQ_VACIA && IRC_Cursor_Active(sesion) == TRUE && IRC_Cursor_Step(sesion) == TRUE)
+			IRC_Reactor_Pending(reactor, sesion);
+	}
+}
+
+/**
+* @brief Atiende los temporizadores vencidos hasta el segundo actual
+*
+* Cada sesion tiene un solo temporizador. Al vencer, IRC_Ping_Pong decide si hay que mandar
+* PING o cerrar, y dice cuando volver a mirar. La actividad no reprograma el temporizador, se
+* tiene en cuenta al vencer.
+*
+* @param reactor reactor que avanza su rueda
+* @param ahora segundo actual
+*/
+static void IRC_Reactor_Timers(Reactor *reactor, long ahora)
+{
+	Timer *temporizador;
+	Session *sesion;
+	long vence;
+
+	IRC_Timer_Advance(&reactor->rueda, ahora);
+
+	while((temporizador = IRC_Timer_Next(&reactor->rueda)) != NULL){
+		sesion = (Session *) temporizador->dueno;
+		if(sesion->cerrar == TRUE)
+			continue;
+
+		if((vence = IRC_Ping_Pong(sesion, ahora)) < 0){
+			sesion->cerrar = TRUE;
+			IRC_Reactor_Pending(reactor, sesion);
+		}else{
+			IRC_Timer_Add(&reactor->rueda, temporizador, vence);
+		}
+	}
+}
+
+/**
+* @brief Lee todo lo disponible en una conexion y ejecuta los comandos recibidos
+*
+* Se lee hasta vaciar el buffer del kernel como exige edge-triggered. Tras cada lectura se ejecutan
+* todas las lineas completas, las partidas se quedan en el buffer hasta que llegue el resto.
+*
+* @param sesion sesion del cliente que tiene datos
+* @retval TRUE si hay que cerrar la conexion
+* @retval FALSE si la conexion sigue abierta
+*/
+static long IRC_Reactor_Read(Session *sesion)
+{
+	char *command;
+	ssize_t leidos;
+
+	while(1){
+		leidos = IRC_Framer_Read(&sesion->entrada, sesion->desc, MSG_DONTWAIT);
+		if(leidos == 0)
+			return TRUE;
+		if(leidos < 0){
+			if(errno == EINTR)
+				continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+				return FALSE;
+			return TRUE;
+		}
+
+		while((command = IRC_Framer_Next(&sesion->entrada)) != NULL){
+			if(IRC_Server_Parser(command, sesion) == TRUE)
+				return TRUE;
+		}
+	}
+}
+
+/**
+* @brief Bucle de eventos de un reactor
+*
+* @param arg puntero void al reactor
+*/
+static void *IRC_Reactor_Loop(void *arg)
+{
+	Reactor *reactor = (Reactor *) arg;
+	int nfds, i;
+	long ahora;
+	struct epoll_event ev, eventos[MAX_EVENTS];
+	Session *sesion;
+
+	reactor_actual = reactor;
+	IRC_Timer_Init(&reactor->rueda, IRC_Timer_Now());
+
+	if((reactor->epfd = epoll_create1(0)) < 0){
+		IRC_Log(LOG_ERR, "Error creating epoll of reactor %d", reactor->id);
+		exit(EXIT_FAILURE);
+	}
+
+	fcntl(reactor->sockval, F_SETFL, fcntl(reactor->sockval, F_GETFL, 0) | O_NONBLOCK);
+
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.ptr = NULL; /*El socket del servidor no tiene sesion*/
+	if(epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, reactor->sockval, &ev) < 0){
+		IRC_Log(LOG_ERR, "Error adding server socket to epoll");
+		exit(EXIT_FAILURE);
+	}
+
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.ptr = reactor; /*El eventfd se reconoce por apuntar al propio reactor*/
+	if(epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, reactor->avisos, &ev) < 0){
+		IRC_Log(LOG_ERR, "Error adding eventfd to epoll");
+		exit(EXIT_FAILURE);
+	}
+
+	while(1){
+		/*Con cuotas de LIST o WHO por enviar no se espera*/
+		nfds = epoll_wait(reactor->epfd, eventos, MAX_EVENTS, reactor->pendientes != NULL ? 0 : TIMER_TICK);
+		/*SIGINT solo despierta a los reactores, se termina desde aqui*/
+		IRC_Stop_Server();
+		if(nfds < 0){
+			if(errno == EINTR)
+				continue;
+			IRC_Log(LOG_ERR, "Error in epoll_wait");
+			exit(EXIT_FAILURE);
+		}
+		ahora = IRC_Timer_Now();
+
+		for(i = 0; i < nfds; i++){
+			if(eventos[i].data.ptr == NULL){
+				IRC_Reactor_Accept(reactor);
+				continue;
+			}
+			if(eventos[i].data.ptr == reactor){
+				IRC_Reactor_Mailbox(reactor);
+				continue;
+			}
+
+			/*Los cierres se aplazan al final de la vuelta, puede haber mas eventos de la sesion*/
+			sesion = (Session *) eventos[i].data.ptr;
+			if(sesion->cerrar == TRUE)
+				continue;
+			if(eventos[i].events & EPOLLIN){
+				sesion->actividad = ahora;
+				sesion->ping = 0;
+				if(IRC_Reactor_Read(sesion) == TRUE)
+					sesion->cerrar = TRUE;
+				else if(sesion->estado == SESION_ESPERA)
+					/*NICK y USER esperan al DNS, el temporizador pasa a vencer con el plazo del resolvedor*/
+					IRC_Timer_Add(&reactor->rueda, &sesion->temporizador, IRC_Ping_Pong(sesion, ahora));
+			}
+			if(eventos[i].events & (EPOLLERR | EPOLLHUP))
+				sesion->cerrar = TRUE;
+			IRC_Reactor_Pending(reactor, sesion);
+		}
+
+		IRC_Reactor_Timers(reactor, ahora);
+		IRC_Reactor_Flush(reactor);
+	}
+	return NULL;
+}
+
+/**
+ * @page IRC_Reactor_Run IRC_Reactor_Run
+ * @brief Atiende a todos los clientes con un reactor por nucleo
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reactor.h"
+ *
+ * void IRC_Reactor_Run(int sockval, int nreactores)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Lanza nreactores bucles de eventos. El primero usa el socket del servidor y se ejecuta en el
+ * hilo que llama a la funcion, el resto abren su propio socket de escucha en el mismo puerto con
+ * IRC_Open_Socket y se ejecutan cada uno en su hilo.
+ *
+ * Cada conexion tiene su sesion, que se guarda en el propio evento de epoll, de forma que al
+ * llegar datos no hay que buscar nada. Cuando un cliente hace QUIT o cierra la conexion se
+ * elimina de epoll y se libera su sesion.
+ * Esta funcion no retorna nunca.
+ *
+ * @param[in] sockval Valor del descriptor del servidor obtenido al crear el socket.
+ * @param[in] nreactores Numero de reactores, si es menor que 1 se lanza uno por nucleo.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reactor_Run(int sockval, int nreactores)
+{
+	int i;
+
+	if(nreactores < 1)
+		nreactores = sysconf(_SC_NPROCESSORS_ONLN);
+	if(nreactores < 1)
+		nreactores = 1;
+	if(nreactores > MAX_REACTORS)
+		nreactores = MAX_REACTORS;
+
+	IRC_Log(LOG_INFO, "Launching %d reactors", nreactores);
+
+	for(i = 0; i < nreactores; i++){
+		reactores[i].id = i;
+		reactores[i].sockval = (i == 0) ? sockval : IRC_Open_Socket();
+		reactores[i].buzon = reactores[i].ultima = NULL;
+		reactores[i].pendientes = NULL;
+		pthread_mutex_init(&reactores[i].mutex, NULL);
+		/*El eventfd se crea antes de lanzarlos para que IRC_Reactor_Wake pueda usarlo*/
+		if((reactores[i].avisos = eventfd(0, EFD_NONBLOCK)) < 0){
+			IRC_Log(LOG_ERR, "Error creating eventfd of reactor %d", i);
+			exit(EXIT_FAILURE);
+		}
+		lanzados = i + 1;
+	}
+
+	for(i = 1; i < nreactores; i++){
+		if(pthread_create(&reactores[i].hilo, NULL, IRC_Reactor_Loop, (void *) &reactores[i]) != 0){
+			IRC_Log(LOG_ERR, "Error launching reactor %d", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	IRC_Reactor_Loop((void *) &reactores[0]);
+}
+
+/**
+ * @page IRC_Reactor_Send IRC_Reactor_Send
+ * @brief Envia un mensaje a un descriptor desde cualquier reactor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reactor.h"
+ *
+ * void IRC_Reactor_Send(Session *sesion, char *msg)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Si el servidor esta en el modelo de hilos el mensaje se envia directamente. Si no, se copia
+ * una vez en un buffer compartido y se entrega con IRC_Reactor_SendBuffer.
+ *
+ * @param[in] sesion sesion destino
+ * @param[in] msg mensaje terminado en '\0' que se quiere enviar
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reactor_Send(Session *sesion, char *msg)
+{
+	Buffer *buffer;
+
+	if(msg == NULL || sesion == NULL || sesion->desc < 0)
+		return;
+
+	if(sesion->desc >= MAX_DESCRIPTORS || propietarios[sesion->desc] == NULL){
+		send(sesion->desc, msg, strlen(msg), 0);
+		return;
+	}
+
+	if((buffer = IRC_Buffer_New(msg, strlen(msg))) == NULL)
+		return;
+	IRC_Reactor_SendBuffer(sesion, buffer);
+	IRC_Buffer_Unref(buffer);
+}
+
+/**
+ * @page IRC_Reactor_SendBuffer IRC_Reactor_SendBuffer
+ * @brief Envia un mensaje compartido a un descriptor desde cualquier reactor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reactor.h"
+ *
+ * void IRC_Reactor_SendBuffer(Session *sesion, Buffer *buffer)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es la forma de repartir un mismo mensaje a muchos destinatarios: se formatea una vez en un
+ * buffer y se llama a esta funcion por cada uno, que solo añade una referencia.
+ *
+ * Si el descriptor lo atiende el reactor del hilo que llama el buffer se enlaza en su cola de
+ * salida, que se envia al final de la vuelta. Si lo atiende otro reactor se deja la referencia
+ * en el buzon de ese reactor y se le despierta para que lo encole el, de modo que cada conexion
+ * solo la toca el hilo que la atiende. La entrega lleva el identificador de la sesion, y si
+ * al vaciar el buzon el descriptor ya es de otra conexion se descarta. En el modelo de hilos se
+ * envia directamente.
+ *
+ * @param[in] sesion sesion destino
+ * @param[in] buffer mensaje ya formateado, quien llama conserva su referencia
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reactor_SendBuffer(Session *sesion, Buffer *buffer)
+{
+	Reactor *destino;
+	int desc;
+
+	if(buffer == NULL || sesion == NULL || (desc = sesion->desc) < 0)
+		return;
+
+	destino = (desc < MAX_DESCRIPTORS) ? propietarios[desc] : NULL;
+
+	if(destino == NULL){
+		send(desc, buffer->datos, buffer->len, 0);
+		return;
+	}
+	if(destino == reactor_actual){
+		IRC_Reactor_Write(destino, desc, buffer);
+		return;
+	}
+
+	IRC_Reactor_Post(destino, desc, sesion->id, IRC_Buffer_Ref(buffer));
+}
+
+/**
+ * @page IRC_Reactor_Notify IRC_Reactor_Notify
+ * @brief Avisa al reactor de una conexion de que ya se ha resuelto su host
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reactor.h"
+ *
+ * void IRC_Reactor_Notify(int desc, long id)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La llaman los hilos del resolvedor al terminar una consulta. Deja un aviso en el buzon del
+ * reactor que atiende el descriptor, que termina el registro aplazado de la sesion si sigue
+ * siendo la misma. En el modelo de hilos no hace nada, el hilo del cliente espera por su cuenta.
+ *
+ * @param[in] desc descriptor de la conexion
+ * @param[in] id identificador de la sesion que pidio la resolucion
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reactor_Notify(int desc, long id)
+{
+	Reactor *destino;
+
+	if(desc < 0 || desc >= MAX_DESCRIPTORS || (destino = propietarios[desc]) == NULL)
+		return;
+
+	IRC_Reactor_Post(destino, desc, id, NULL);
+}
+
+/**
+ * @page IRC_Reactor_Wake IRC_Reactor_Wake
+ * @brief Despierta a todos los reactores
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reactor.h"
+ *
+ * void IRC_Reactor_Wake()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Escribe en el eventfd de cada reactor, que sale de epoll_wait aunque no tenga nada que hacer.
+ * Solo usa write, asi que se puede llamar desde un manejador de señal. La usa IRC_End_Server
+ * para que los reactores terminen el servidor al recibir SIGINT. En el modelo de hilos no hace
+ * nada.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reactor_Wake()
+{
+	uint64_t uno = 1;
+	int i;
+
+	for(i = 0; i < lanzados; i++)
+		if(write(reactores[i].avisos, &uno, sizeof(uno)) < 0)
+			continue;
+}
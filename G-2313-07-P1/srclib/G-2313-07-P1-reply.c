@@ -0,0 +1,560 @@
+/**
+* @brief Constructor de respuestas del servidor
+* @file G-2313-07-P1-reply.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+
+/*! @page irc_reply Respuestas del servidor
+*
+* <p>Esta sección incluye la construccion de las respuestas.</p>
+*
+* <p>Cada hilo tiene una arena de REPLY_ARENA bytes. El parser la abre con IRC_Reply_Begin
+* antes de llamar al manejador, las respuestas se formatean directamente en ella con las macros de
+* cada numerico y al terminar el comando IRC_Reply_End encola todo de una vez en un solo buffer y
+* la vacia poniendo la longitud a cero. Una respuesta de varios cientos de lineas cuesta la misma
+* reserva que una de una linea, y solo si pasa de REPLY_ARENA bytes se encola por partes.<br>
+* Las lineas se cortan a MAX_BUFFER bytes con su CR/LF. Los mensajes que van a otros clientes,
+* como un PRIVMSG o un JOIN a un canal, se formatean con IRC_Reply_Shared en un buffer que se
+* reparte por referencia.<br>
+* Las respuestas con listas de nombres, como RPL_NAMREPLY o RPL_WHOISCHANNELS, se construyen con
+* IRC_Reply_ListOpen e IRC_Reply_ListAdd, que copian cada nombre una vez al final de la linea y
+* empiezan otra con la misma cabecera cuando el siguiente ya no cabe en MAX_BUFFER bytes.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-reply.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Reply_Begin</li>
+* <li>@subpage IRC_Reply_End</li>
+* <li>@subpage IRC_Reply_Written</li>
+* <li>@subpage IRC_Reply_Line</li>
+* <li>@subpage IRC_Reply_Bytes</li>
+* <li>@subpage IRC_Reply_Numeric</li>
+* <li>@subpage IRC_Reply_Shared</li>
+* <li>@subpage IRC_Reply_ListOpen</li>
+* <li>@subpage IRC_Reply_ListAdd</li>
+* <li>@subpage IRC_Reply_ListClose</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static _Thread_local Arena arena; /*!<Respuestas del comando que atiende el hilo*/
+
+
+/*Encola al cliente lo acumulado en un solo buffer y vacia la arena*/
+static void IRC_Reply_Flush()
+{
+	Buffer *buffer;
+
+	if(arena.len == 0)
+		return;
+
+	if((buffer = IRC_Buffer_New(arena.datos, arena.len)) != NULL){
+		IRC_Reactor_SendBuffer(arena.sesion, buffer);
+		IRC_Buffer_Unref(buffer);
+	}
+	arena.enviados += arena.len;
+	arena.len = 0;
+}
+
+/*Hueco para una linea mas al final de la arena, encolando lo anterior si no cabe*/
+static char *IRC_Reply_Slot()
+{
+	if(arena.sesion == NULL)
+		return NULL;
+	if(REPLY_ARENA - arena.len < MAX_BUFFER)
+		IRC_Reply_Flush();
+
+	return arena.datos + arena.len;
+}
+
+/*Termina una linea de n bytes recortandola a MAX_BUFFER con su CR/LF*/
+static size_t IRC_Reply_Close(char *linea, size_t n)
+{
+	if(n > MAX_BUFFER - 2)
+		n = MAX_BUFFER - 2;
+	linea[n++] = '\r';
+	linea[n++] = '\n';
+
+	return n;
+}
+
+/*Escribe ":servidor nnn nick " al principio de la linea, devuelve sus bytes*/
+static int IRC_Reply_Header(char *linea, int numerico)
+{
+	return snprintf(linea, MAX_BUFFER - 1, ":%s %03d %s ", SERVER, numerico,
+		arena.sesion->nick[0] != '\0' ? arena.sesion->nick : "*");
+}
+
+/*Copia a la arena una linea ya formateada de n bytes*/
+static void IRC_Reply_Raw(const char *texto, size_t n)
+{
+	char *linea;
+
+	if((linea = IRC_Reply_Slot()) == NULL)
+		return;
+
+	memcpy(linea, texto, n);
+	arena.len += IRC_Reply_Close(linea, n);
+}
+
+/**
+ * @page IRC_Reply_Begin IRC_Reply_Begin
+ * @brief Empieza a acumular las respuestas de un comando para un cliente
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_Begin(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Deja la arena del hilo vacia y dirigida al cliente. Las llamadas se pueden anidar, como cuando
+ * NICK termina el registro, y solo la mas externa elige el cliente.
+ *
+ * @param[in] sesion cliente al que van las respuestas
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_Begin(Session *sesion)
+{
+	if(arena.abiertas++ > 0)
+		return;
+
+	arena.sesion = sesion;
+	arena.len = arena.enviados = 0;
+}
+
+/**
+ * @page IRC_Reply_End IRC_Reply_End
+ * @brief Encola al cliente todo lo acumulado y deja la arena vacia
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_End()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Cierra la IRC_Reply_Begin correspondiente. Con la mas externa pasa toda la arena a un buffer
+ * que se envia con IRC_Reactor_SendBuffer y la deja vacia de una vez.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_End()
+{
+	if(arena.abiertas == 0 || --arena.abiertas > 0)
+		return;
+
+	IRC_Reply_Flush();
+	arena.sesion = NULL;
+}
+
+/**
+ * @page IRC_Reply_Written IRC_Reply_Written
+ * @brief Bytes de respuesta generados para el cliente en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * size_t IRC_Reply_Written()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Cuenta lo que sigue en la arena y lo que ya se ha encolado por no caber desde la
+ * IRC_Reply_Begin mas externa. Los cursores de @ref irc_cursor la usan para parar cuando han
+ * generado su cuota.
+ *
+ * @retval size_t bytes generados
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+size_t IRC_Reply_Written()
+{
+	return arena.enviados + arena.len;
+}
+
+/**
+ * @page IRC_Reply_Line IRC_Reply_Line
+ * @brief Añade una linea al cliente en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_Line(const char *formato, ...)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Formatea la linea directamente en la arena y le añade el CR/LF. Se usa para los comandos que se
+ * devuelven al propio cliente, como PONG o NICK.
+ *
+ * @param[in] formato formato como el de printf, seguido de sus argumentos
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_Line(const char *formato, ...)
+{
+	va_list args;
+	char *linea;
+	int n;
+
+	if((linea = IRC_Reply_Slot()) == NULL)
+		return;
+
+	va_start(args, formato);
+	n = vsnprintf(linea, MAX_BUFFER - 1, formato, args);
+	va_end(args);
+
+	if(n >= 0)
+		arena.len += IRC_Reply_Close(linea, n);
+}
+
+/**
+ * @page IRC_Reply_Bytes IRC_Reply_Bytes
+ * @brief Añade bytes ya formateados al cliente en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_Bytes(const char *datos, size_t n)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia los bytes tal cual, sin formatear ni añadir CR/LF, encolando lo acumulado cada vez que la
+ * arena se llena. La usan las plantillas de @ref irc_welcome, que pueden ocupar muchas lineas.
+ *
+ * @param[in] datos bytes que se copian, con los CR/LF de sus lineas
+ * @param[in] n numero de bytes
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_Bytes(const char *datos, size_t n)
+{
+	size_t trozo;
+
+	if(arena.sesion == NULL)
+		return;
+
+	while(n > 0){
+		if(arena.len == REPLY_ARENA)
+			IRC_Reply_Flush();
+		trozo = REPLY_ARENA - arena.len;
+		if(trozo > n)
+			trozo = n;
+		memcpy(arena.datos + arena.len, datos, trozo);
+		arena.len += trozo;
+		datos += trozo;
+		n -= trozo;
+	}
+}
+
+/**
+ * @page IRC_Reply_Numeric IRC_Reply_Numeric
+ * @brief Añade una respuesta numerica al cliente en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_Numeric(int numerico, const char *formato, ...)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Escribe ":servidor nnn nick " y despues el resto de la respuesta, todo en la arena. Si el cliente
+ * aun no tiene nick se usa "*". Normalmente no se llama directamente sino a traves de las macros
+ * IRC_Reply_ de cada numerico, que fijan su codigo y su texto.
+ *
+ * @param[in] numerico codigo de la respuesta
+ * @param[in] formato formato como el de printf de lo que va despues del nick
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_Numeric(int numerico, const char *formato, ...)
+{
+	va_list args;
+	char *linea;
+	int n, resto;
+
+	if((linea = IRC_Reply_Slot()) == NULL)
+		return;
+
+	n = IRC_Reply_Header(linea, numerico);
+
+	va_start(args, formato);
+	resto = vsnprintf(linea + n, MAX_BUFFER - 1 - n, formato, args);
+	va_end(args);
+
+	if(resto >= 0)
+		arena.len += IRC_Reply_Close(linea, n + resto);
+}
+
+/**
+ * @page IRC_Reply_Shared IRC_Reply_Shared
+ * @brief Formatea una linea en un buffer para enviarla a otros clientes
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * Buffer *IRC_Reply_Shared(const char *formato, ...)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Formatea en la pila y copia al buffer, una sola reserva en lugar de la del IRCMsg y la del
+ * buffer. El buffer se reparte con IRC_Reactor_SendBuffer o IRC_Channels_Send y quien lo crea
+ * suelta su referencia con IRC_Buffer_Unref.
+ *
+ * @param[in] formato formato como el de printf, sin CR/LF
+ *
+ * @retval Buffer* el buffer con una referencia
+ * @retval NULL si no hay memoria
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Buffer *IRC_Reply_Shared(const char *formato, ...)
+{
+	va_list args;
+	char linea[MAX_BUFFER];
+	int n;
+
+	va_start(args, formato);
+	n = vsnprintf(linea, MAX_BUFFER - 1, formato, args);
+	va_end(args);
+
+	if(n < 0)
+		return NULL;
+
+	return IRC_Buffer_New(linea, IRC_Reply_Close(linea, n));
+}
+
+/**
+ * @page IRC_Reply_ListOpen IRC_Reply_ListOpen
+ * @brief Empieza una respuesta numerica con lista de nombres
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_ListOpen(Lista *lista, int numerico, const char *formato, ...)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Compone la cabecera que se repetira en cada linea, ":servidor nnn nick " seguido del formato,
+ * que debe acabar en ':' para que los nombres vayan en el ultimo parametro. Normalmente se usa a
+ * traves de IRC_Reply_NamReply o IRC_Reply_WhoisChannels.
+ *
+ * @param[out] lista lista que se inicializa
+ * @param[in] numerico codigo de la respuesta
+ * @param[in] formato formato como el de printf de lo que va despues del nick
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_ListOpen(Lista *lista, int numerico, const char *formato, ...)
+{
+	va_list args;
+	int n, resto;
+
+	lista->cabecera = lista->len = 0;
+	if(arena.sesion == NULL)
+		return;
+
+	n = IRC_Reply_Header(lista->linea, numerico);
+
+	va_start(args, formato);
+	resto = vsnprintf(lista->linea + n, MAX_BUFFER - 1 - n, formato, args);
+	va_end(args);
+
+	if(resto < 0)
+		resto = 0;
+	lista->cabecera = lista->len = (n + resto > MAX_BUFFER - 2) ? MAX_BUFFER - 2 : n + resto;
+}
+
+/**
+ * @page IRC_Reply_ListAdd IRC_Reply_ListAdd
+ * @brief Añade un nombre a la lista
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_ListAdd(Lista *lista, const char *prefijo, const char *nombre)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia el prefijo y el nombre al final de la linea, separados del anterior por un espacio. Si
+ * con el no caben la linea y su CR/LF en MAX_BUFFER bytes, la linea se pasa a la arena y el nombre
+ * empieza otra detras de la cabecera. Cada nombre se copia una vez, asi que una lista de n nombres
+ * cuesta O(n) en lugar de los strcat que volvian a recorrer la cadena entera.
+ *
+ * @param[in,out] lista lista abierta con IRC_Reply_ListOpen
+ * @param[in] prefijo lo que va pegado delante del nombre, como "@" o "+", o ""
+ * @param[in] nombre nick o canal que se añade
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_ListAdd(Lista *lista, const char *prefijo, const char *nombre)
+{
+	size_t lprefijo = strlen(prefijo), lnombre = strlen(nombre);
+	size_t espacio = (lista->len > lista->cabecera) ? 1 : 0;
+
+	if(lista->cabecera == 0)
+		return;
+
+	if(espacio == 1 && lista->len + 1 + lprefijo + lnombre > MAX_BUFFER - 2){
+		IRC_Reply_Raw(lista->linea, lista->len);
+		lista->len = lista->cabecera;
+		espacio = 0;
+	}
+
+	/*Un nombre que no cabe ni solo en la linea no se puede enviar*/
+	if(lista->len + espacio + lprefijo + lnombre > MAX_BUFFER - 2)
+		return;
+
+	if(espacio == 1)
+		lista->linea[lista->len++] = ' ';
+	memcpy(lista->linea + lista->len, prefijo, lprefijo);
+	lista->len += lprefijo;
+	memcpy(lista->linea + lista->len, nombre, lnombre);
+	lista->len += lnombre;
+}
+
+/**
+ * @page IRC_Reply_ListClose IRC_Reply_ListClose
+ * @brief Termina una respuesta numerica con lista de nombres
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-reply.h"
+ *
+ * void IRC_Reply_ListClose(Lista *lista)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Pasa a la arena la linea que se estaba llenando. Si la lista no tiene ningun nombre no se
+ * envia nada.
+ *
+ * @param[in,out] lista lista abierta con IRC_Reply_ListOpen
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Reply_ListClose(Lista *lista)
+{
+	if(lista->len > lista->cabecera)
+		IRC_Reply_Raw(lista->linea, lista->len);
+
+	lista->len = lista->cabecera;
+}
@@ -0,0 +1,404 @@
+/**
+* @brief Resolucion inversa asincrona de los nombres de los clientes
+* @file G-2313-07-P1-resolver.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-resolver.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-timer.h"
+
+/*! @page irc_resolver Resolucion de nombres
+*
+* <p>Esta sección incluye la resolucion del nombre de host de cada cliente, sin que un DNS
+* lento pare a los hilos que atienden a los clientes.</p>
+*
+* <p>La consulta empieza al aceptar la conexion y la hacen unos hilos propios con
+* getnameinfo. Los resultados se guardan en una cache con caducidad, tambien los fallos, asi
+* que una IP que se reconecta no vuelve a preguntar al DNS. Cada IP tiene un solo hueco en la
+* cache y otra IP puede quitarselo, asi que el hilo tambien deja el resultado en la propia
+* consulta, apuntada por el descriptor que la espera, y la sesion lo recoge de ahi aunque la
+* cache ya no lo tenga. Al tener NICK y USER, si el nombre
+* aun no esta, la sesion se queda en SESION_ESPERA: el reactor lo retoma cuando el hilo del resolvedor le avisa
+* de que ha terminado, o con la IP cuando pasan RESOLVER_PLAZO segundos desde la conexion.<br>
+* Si hay mas de RESOLVER_COLA consultas pendientes, como en una avalancha de reconexiones,
+* las nuevas conexiones se registran directamente con la IP en vez de esperar en la cola.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-resolver.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Resolver_Init</li>
+* <li>@subpage IRC_Resolver_Start</li>
+* <li>@subpage IRC_Resolver_Host</li>
+* <li>@subpage IRC_Resolver_Wait</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;   /*!<Protege la cola y la cache*/
+static pthread_cond_t hay_consultas = PTHREAD_COND_INITIALIZER; /*!<Avisa a los hilos de que hay trabajo*/
+static pthread_cond_t resuelta = PTHREAD_COND_INITIALIZER;  /*!<Avisa a quien espera en IRC_Resolver_Wait*/
+static Consulta *primera = NULL;           /*!<Primera consulta de la cola*/
+static Consulta *ultima = NULL;            /*!<Ultima consulta de la cola*/
+static int pendientes = 0;                 /*!<Consultas en la cola*/
+static Resuelto cache[RESOLVER_CACHE];     /*!<Cache de nombres, cada IP tiene un solo hueco posible*/
+static Consulta *hechas[MAX_DESCRIPTORS];  /*!<Ultima consulta terminada de cada descriptor, hasta que su sesion la recoge*/
+
+
+/*Hueco de la cache que le toca a una IP*/
+static Resuelto *IRC_Resolver_Slot(struct in_addr ip)
+{
+	unsigned long h = (unsigned long) ip.s_addr * 2654435761UL;
+
+	return &cache[(h >> 7) & (RESOLVER_CACHE-1)];
+}
+
+/*Entrada valida de la cache para la IP, o NULL. Hay que tener el mutex*/
+static Resuelto *IRC_Resolver_Find(struct in_addr ip, long ahora)
+{
+	Resuelto *entrada = IRC_Resolver_Slot(ip);
+
+	if(entrada->ip.s_addr != ip.s_addr || entrada->expira <= ahora)
+		return NULL;
+
+	return entrada;
+}
+
+/*Quita la consulta terminada que guarda un descriptor, si la hay. Hay que tener el mutex*/
+static void IRC_Resolver_Drop(int desc)
+{
+	if(desc < 0 || desc >= MAX_DESCRIPTORS)
+		return;
+
+	free(hechas[desc]);
+	hechas[desc] = NULL;
+}
+
+/*Copia el resultado de la consulta de la sesion, o de la cache, a la sesion si ya lo hay. Hay que tener el mutex*/
+static long IRC_Resolver_Check(Session *sesion, long ahora)
+{
+	Resuelto *entrada;
+	Consulta *consulta;
+
+	if(sesion->resuelto == TRUE)
+		return TRUE;
+
+	consulta = (sesion->desc >= 0 && sesion->desc < MAX_DESCRIPTORS) ? hechas[sesion->desc] : NULL;
+	entrada = IRC_Resolver_Find(sesion->direccion, ahora);
+	if(consulta != NULL && consulta->id == sesion->id){
+		if(consulta->estado == RESOLVER_OK)
+			strcpy(sesion->host, consulta->host);
+		sesion->resuelto = TRUE;
+		IRC_Resolver_Drop(sesion->desc);
+	}else if(entrada != NULL && entrada->estado != RESOLVER_PENDIENTE){
+		if(entrada->estado == RESOLVER_OK)
+			strcpy(sesion->host, entrada->host);
+		sesion->resuelto = TRUE;
+	}else if(ahora - sesion->creada >= RESOLVER_PLAZO){
+		IRC_Log(LOG_INFO, "DNS timeout for %s, using IP", sesion->ip);
+		sesion->resuelto = TRUE;
+	}
+
+	return sesion->resuelto;
+}
+
+/*Hilo del resolvedor: saca consultas, pregunta al DNS, guarda el resultado en la cache y en la consulta y avisa al reactor*/
+static void *IRC_Resolver_Worker(void *arg)
+{
+	Consulta *consulta;
+	Resuelto *entrada;
+	struct sockaddr_in addr;
+	char host[MAX_HOST];
+	long hecha, id;
+	int error, desc;
+
+	while(1){
+		pthread_mutex_lock(&mutex);
+		while(primera == NULL)
+			pthread_cond_wait(&hay_consultas, &mutex);
+		consulta = primera;
+		primera = consulta->sig;
+		if(primera == NULL)
+			ultima = NULL;
+		pendientes--;
+		desc = consulta->desc;
+		id = consulta->id;
+
+		/*Otra conexion desde la misma IP puede haberla resuelto ya*/
+		entrada = IRC_Resolver_Find(consulta->ip, IRC_Timer_Now());
+		hecha = (entrada != NULL && entrada->estado != RESOLVER_PENDIENTE) ? TRUE : FALSE;
+		if(hecha == TRUE){
+			consulta->estado = entrada->estado;
+			strcpy(consulta->host, entrada->host);
+		}
+		pthread_mutex_unlock(&mutex);
+
+		if(hecha == FALSE){
+			memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_addr = consulta->ip;
+			error = getnameinfo((struct sockaddr *) &addr, sizeof(addr), host, sizeof(host), NULL, 0, NI_NAMEREQD);
+			consulta->estado = (error == 0) ? RESOLVER_OK : RESOLVER_FALLO;
+			strcpy(consulta->host, (error == 0) ? host : "");
+		}
+
+		pthread_mutex_lock(&mutex);
+		if(hecha == FALSE){
+			entrada = IRC_Resolver_Slot(consulta->ip);
+			entrada->ip = consulta->ip;
+			entrada->estado = consulta->estado;
+			strcpy(entrada->host, consulta->host);
+			entrada->expira = IRC_Timer_Now() + ((consulta->estado == RESOLVER_OK) ? RESOLVER_TTL : RESOLVER_TTL_FALLO);
+		}
+		/*La sesion la recoge de aqui aunque otra IP le quite el hueco, salvo que el descriptor ya sea de una conexion posterior*/
+		if(desc >= 0 && desc < MAX_DESCRIPTORS && (hechas[desc] == NULL || hechas[desc]->id < id)){
+			IRC_Resolver_Drop(desc);
+			hechas[desc] = consulta;
+		}else{
+			free(consulta);
+		}
+		pthread_cond_broadcast(&resuelta);
+		pthread_mutex_unlock(&mutex);
+
+		IRC_Reactor_Notify(desc, id);
+	}
+
+	return NULL;
+}
+
+/**
+ * @page IRC_Resolver_Init IRC_Resolver_Init
+ * @brief Lanza los hilos del resolvedor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-resolver.h"
+ *
+ * void IRC_Resolver_Init(int nhilos)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Lanza los hilos que atienden la cola de consultas. Se llama una vez al iniciar el servidor,
+ * antes de aceptar conexiones.
+ *
+ * @param[in] nhilos numero de hilos, si es menor que 1 se usan RESOLVER_HILOS
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Resolver_Init(int nhilos)
+{
+	pthread_t hilo;
+	int i;
+
+	if(nhilos < 1)
+		nhilos = RESOLVER_HILOS;
+
+	for(i = 0; i < nhilos; i++){
+		if(pthread_create(&hilo, NULL, IRC_Resolver_Worker, NULL) != 0){
+			IRC_Log(LOG_ERR, "Error launching resolver thread %d", i);
+			exit(EXIT_FAILURE);
+		}
+		pthread_detach(hilo);
+	}
+}
+
+/**
+ * @page IRC_Resolver_Start IRC_Resolver_Start
+ * @brief Empieza a resolver el nombre de una conexion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-resolver.h"
+ *
+ * void IRC_Resolver_Start(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Obtiene la IP del cliente con getpeername y la deja tambien como host provisional. Si la
+ * cache ya tiene la respuesta la usa directamente, si no encola la consulta para los hilos
+ * del resolvedor. Con la cola llena no se encola nada y el cliente se registra con la IP.
+ *
+ * @param[in] sesion sesion de la conexion recien aceptada
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Resolver_Start(Session *sesion)
+{
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	Resuelto *entrada;
+	Consulta *consulta;
+	long ahora = IRC_Timer_Now();
+
+	sesion->resuelto = TRUE;
+	strcpy(sesion->ip, "0.0.0.0");
+	if(getpeername(sesion->desc, (struct sockaddr *) &addr, &len) < 0 || addr.sin_family != AF_INET){
+		strcpy(sesion->host, sesion->ip);
+		return;
+	}
+	sesion->direccion = addr.sin_addr;
+	inet_ntop(AF_INET, &addr.sin_addr, sesion->ip, sizeof(sesion->ip));
+	strcpy(sesion->host, sesion->ip);
+
+	pthread_mutex_lock(&mutex);
+
+	/*Lo que quede de la conexion anterior con este descriptor ya no lo va a recoger nadie*/
+	IRC_Resolver_Drop(sesion->desc);
+	sesion->resuelto = FALSE;
+	if(IRC_Resolver_Check(sesion, ahora) == TRUE){
+		pthread_mutex_unlock(&mutex);
+		return;
+	}
+
+	if(pendientes >= RESOLVER_COLA || (consulta = (Consulta *) malloc(sizeof(Consulta))) == NULL){
+		pthread_mutex_unlock(&mutex);
+		IRC_Log(LOG_INFO, "Resolver queue full, registering %s by IP", sesion->ip);
+		sesion->resuelto = TRUE;
+		return;
+	}
+
+	entrada = IRC_Resolver_Slot(addr.sin_addr);
+	if(IRC_Resolver_Find(addr.sin_addr, ahora) == NULL){
+		entrada->ip = addr.sin_addr;
+		entrada->estado = RESOLVER_PENDIENTE;
+		entrada->expira = ahora + RESOLVER_PLAZO;
+	}
+
+	consulta->ip = addr.sin_addr;
+	consulta->desc = sesion->desc;
+	consulta->id = sesion->id;
+	consulta->estado = RESOLVER_PENDIENTE;
+	consulta->sig = NULL;
+	if(ultima == NULL)
+		primera = consulta;
+	else
+		ultima->sig = consulta;
+	ultima = consulta;
+	pendientes++;
+	pthread_cond_signal(&hay_consultas);
+
+	pthread_mutex_unlock(&mutex);
+}
+
+/**
+ * @page IRC_Resolver_Host IRC_Resolver_Host
+ * @brief Comprueba si el host de la sesion ya es definitivo
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-resolver.h"
+ *
+ * long IRC_Resolver_Host(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Mira sin bloquearse la consulta terminada de la sesion y la cache. Si ya hay respuesta la
+ * copia al host de la sesion; si no
+ * la hay pero han pasado RESOLVER_PLAZO segundos desde la conexion se da por buena la IP.
+ *
+ * @param[in] sesion sesion del cliente
+ *
+ * @retval TRUE si ya se puede registrar, el nombre esta en sesion->host
+ * @retval FALSE si hay que esperar al DNS
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Resolver_Host(Session *sesion)
+{
+	long resuelto;
+
+	if(sesion->resuelto == TRUE)
+		return TRUE;
+
+	pthread_mutex_lock(&mutex);
+	resuelto = IRC_Resolver_Check(sesion, IRC_Timer_Now());
+	pthread_mutex_unlock(&mutex);
+
+	return resuelto;
+}
+
+/**
+ * @page IRC_Resolver_Wait IRC_Resolver_Wait
+ * @brief Espera a que el host de la sesion sea definitivo
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-resolver.h"
+ *
+ * void IRC_Resolver_Wait(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La usa el modelo de hilos, donde cada cliente tiene su hilo y puede bloquearse sin parar a
+ * nadie mas. Espera a que algun hilo del resolvedor termine, como mucho hasta que pasan
+ * RESOLVER_PLAZO segundos desde la conexion.
+ *
+ * @param[in] sesion sesion del cliente
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Resolver_Wait(Session *sesion)
+{
+	struct timespec limite;
+
+	pthread_mutex_lock(&mutex);
+	while(IRC_Resolver_Check(sesion, IRC_Timer_Now()) == FALSE){
+		clock_gettime(CLOCK_REALTIME, &limite);
+		limite.tv_sec += 1;
+		pthread_cond_timedwait(&resuelta, &mutex, &limite);
+	}
+	pthread_mutex_unlock(&mutex);
+}
@@ -0,0 +1,373 @@
+/**
+* @brief Cola de salida acotada de cada conexion
+* @file G-2313-07-P1-sendq.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-sendq.h"
+
+/*! @page irc_sendq Cola de salida
+*
+* <p>Esta sección incluye la cola de salida de cada conexion. Los reactores no envian nada
+* directamente, encolan los mensajes y vacian la cola con writev cuando el socket admite datos,
+* juntando en una sola llamada todo lo generado en una vuelta del bucle de eventos.<br>
+* Cada bloque de la cola apunta a un buffer compartido (@ref irc_buffer), asi un mensaje a un
+* canal se formatea una vez y cada miembro solo añade un enlace a su cola. Los enlaces libres se
+* guardan por hilo para no pedir memoria en cada mensaje.<br>
+* La cola esta acotada: si un cliente no lee y acumula mas de lo permitido se le desconecta,
+* de forma que un cliente lento no retrasa al resto de su canal.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-sendq.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_SendQ_Limit</li>
+* <li>@subpage IRC_SendQ_Init</li>
+* <li>@subpage IRC_SendQ_Push</li>
+* <li>@subpage IRC_SendQ_PushBuffer</li>
+* <li>@subpage IRC_SendQ_Flush</li>
+* <li>@subpage IRC_SendQ_Free</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static size_t limite_sendq = SENDQ_DEFAULT; /**< @brief Bytes pendientes permitidos por conexion */
+static _Thread_local Bloque *libres = NULL;  /**< @brief Bloques libres del hilo */
+static _Thread_local int nlibres = 0;        /**< @brief Numero de bloques libres del hilo */
+
+
+/**
+* @brief Saca un bloque de la cache del hilo o lo reserva si esta vacia
+*
+* @retval Bloque* el bloque
+* @retval NULL si no hay memoria
+*/
+static Bloque *IRC_SendQ_NewBlock()
+{
+	Bloque *bloque;
+
+	if((bloque = libres) != NULL){
+		libres = bloque->sig;
+		nlibres--;
+		return bloque;
+	}
+	return (Bloque *) malloc(sizeof(Bloque));
+}
+
+/**
+* @brief Suelta el mensaje del bloque y devuelve el bloque a la cache del hilo
+*
+* @param bloque bloque ya enviado o descartado
+*/
+static void IRC_SendQ_FreeBlock(Bloque *bloque)
+{
+	IRC_Buffer_Unref(bloque->buffer);
+	if(nlibres >= SENDQ_CACHE){
+		free(bloque);
+		return;
+	}
+	bloque->sig = libres;
+	libres = bloque;
+	nlibres++;
+}
+
+/**
+* @brief Enlaza al final de la cola un mensaje cuya referencia pasa a ser de la cola
+*
+* @param cola cola de la conexion
+* @param buffer mensaje, si no se puede encolar se suelta la referencia
+* @retval TRUE si se ha encolado
+* @retval FALSE si se supera el limite o no hay memoria
+*/
+static long IRC_SendQ_Link(SendQ *cola, Buffer *buffer)
+{
+	Bloque *bloque;
+
+	if(cola->pendientes + buffer->len > limite_sendq || (bloque = IRC_SendQ_NewBlock()) == NULL){
+		IRC_Buffer_Unref(buffer);
+		return FALSE;
+	}
+
+	bloque->sig = NULL;
+	bloque->buffer = buffer;
+	bloque->enviado = 0;
+
+	if(cola->ultimo == NULL)
+		cola->primero = bloque;
+	else
+		cola->ultimo->sig = bloque;
+	cola->ultimo = bloque;
+	cola->pendientes += buffer->len;
+
+	return TRUE;
+}
+
+/**
+ * @page IRC_SendQ_Limit IRC_SendQ_Limit
+ * @brief Fija el limite de bytes pendientes por conexion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * void IRC_SendQ_Limit(size_t limite)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Fija cuantos bytes puede tener pendientes una conexion antes de considerarla un cliente lento
+ * y desconectarla. Se llama al arrancar, antes de lanzar los reactores.
+ *
+ * @param[in] limite bytes a partir de los que se desconecta al cliente, 0 deja el valor por defecto
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_SendQ_Limit(size_t limite)
+{
+	if(limite > 0)
+		limite_sendq = limite;
+}
+
+/**
+ * @page IRC_SendQ_Init IRC_SendQ_Init
+ * @brief Deja la cola de salida vacia
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * void IRC_SendQ_Init(SendQ *cola)
+ * @endcode
+ *
+ * @param[in,out] cola cola que se inicializa
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_SendQ_Init(SendQ *cola)
+{
+	cola->primero = cola->ultimo = NULL;
+	cola->pendientes = 0;
+}
+
+/**
+ * @page IRC_SendQ_Push IRC_SendQ_Push
+ * @brief Añade un mensaje al final de la cola de salida
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * long IRC_SendQ_Push(SendQ *cola, const char *msg, size_t len)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia el mensaje en un buffer nuevo al final de la cola. No envia nada, el envio se hace
+ * despues con IRC_SendQ_Flush para juntar varios mensajes en un mismo writev.
+ * Para mensajes que van a varios destinatarios se usa IRC_SendQ_PushBuffer.
+ *
+ * @param[in,out] cola cola de la conexion
+ * @param[in] msg datos que se quieren enviar
+ * @param[in] len longitud de los datos
+ *
+ * @retval TRUE si se ha encolado
+ * @retval FALSE si se supera el limite o no hay memoria, hay que desconectar al cliente
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_SendQ_Push(SendQ *cola, const char *msg, size_t len)
+{
+	Buffer *buffer;
+
+	if(cola->pendientes + len > limite_sendq || (buffer = IRC_Buffer_New(msg, len)) == NULL)
+		return FALSE;
+
+	return IRC_SendQ_Link(cola, buffer);
+}
+
+/**
+ * @page IRC_SendQ_PushBuffer IRC_SendQ_PushBuffer
+ * @brief Añade a la cola un mensaje compartido
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * long IRC_SendQ_PushBuffer(SendQ *cola, Buffer *buffer)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Enlaza el buffer al final de la cola tomando una referencia, sin copiar el mensaje. Es lo que se
+ * usa al repartir un mismo mensaje a todos los miembros de un canal.
+ *
+ * @param[in,out] cola cola de la conexion
+ * @param[in] buffer mensaje ya formateado, quien llama conserva su referencia
+ *
+ * @retval TRUE si se ha encolado
+ * @retval FALSE si se supera el limite o no hay memoria, hay que desconectar al cliente
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_SendQ_PushBuffer(SendQ *cola, Buffer *buffer)
+{
+	return IRC_SendQ_Link(cola, IRC_Buffer_Ref(buffer));
+}
+
+/**
+ * @page IRC_SendQ_Flush IRC_SendQ_Flush
+ * @brief Envia con writev lo que admita el socket
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * int IRC_SendQ_Flush(SendQ *cola, int desc)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Envia los bloques pendientes de SENDQ_IOV en SENDQ_IOV con writev hasta que la cola se queda
+ * vacia o el socket devuelve EAGAIN. En ese caso lo que falta se envia cuando epoll avise de que
+ * el socket vuelve a admitir datos.
+ *
+ * @param[in,out] cola cola de la conexion
+ * @param[in] desc descriptor no bloqueante de la conexion
+ *
+ * @retval SENDQ_VACIA si se ha enviado todo
+ * @retval SENDQ_PENDIENTE si quedan datos por enviar
+ * @retval SENDQ_ERROR si ha fallado el envio
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+int IRC_SendQ_Flush(SendQ *cola, int desc)
+{
+	struct iovec tramos[SENDQ_IOV];
+	Bloque *bloque;
+	ssize_t enviados;
+	size_t resto;
+	int n;
+
+	while(cola->primero != NULL){
+		for(n = 0, bloque = cola->primero; bloque != NULL && n < SENDQ_IOV; bloque = bloque->sig, n++){
+			tramos[n].iov_base = bloque->buffer->datos + bloque->enviado;
+			tramos[n].iov_len = bloque->buffer->len - bloque->enviado;
+		}
+
+		if((enviados = writev(desc, tramos, n)) < 0){
+			if(errno == EINTR)
+				continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+				return SENDQ_PENDIENTE;
+			return SENDQ_ERROR;
+		}
+
+		cola->pendientes -= enviados;
+		while(enviados > 0){
+			bloque = cola->primero;
+			resto = bloque->buffer->len - bloque->enviado;
+			if((size_t) enviados < resto){
+				bloque->enviado += enviados;
+				return SENDQ_PENDIENTE;
+			}
+			enviados -= resto;
+			cola->primero = bloque->sig;
+			IRC_SendQ_FreeBlock(bloque);
+		}
+		if(cola->primero == NULL)
+			cola->ultimo = NULL;
+	}
+
+	return SENDQ_VACIA;
+}
+
+/**
+ * @page IRC_SendQ_Free IRC_SendQ_Free
+ * @brief Libera lo que quede en la cola de salida
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-sendq.h"
+ *
+ * void IRC_SendQ_Free(SendQ *cola)
+ * @endcode
+ *
+ * @param[in,out] cola cola que se vacia
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_SendQ_Free(SendQ *cola)
+{
+	Bloque *bloque;
+
+	while((bloque = cola->primero) != NULL){
+		cola->primero = bloque->sig;
+		IRC_SendQ_FreeBlock(bloque);
+	}
+	cola->ultimo = NULL;
+	cola->pendientes = 0;
+}
@@ -31,6 +31,10 @@
  * Al hacer make sobre el directorio de la practica se genera el ejecutable <b>G-2313-07-P1</b> dentro de la carpeta obj
  * \subsection step2 Paso 2: Ejecución del Servidor
  * El servidor se ejecuta <b>~$: ./obj/G-2313-07-P1 </b> y este se comenzara a ejecutar en segundo plano
+ * <ul><li>Por defecto todos los clientes se atienden desde un bucle de eventos con epoll</li>
+ * <li>Con <b>~$: ./obj/G-2313-07-P1 -r N</b> se lanzan N reactores, por defecto uno por nucleo</li>
+ * <li>Con <b>~$: ./obj/G-2313-07-P1 -q N</b> se desconecta a los clientes con mas de N bytes pendientes de recibir</li>
+ * <li>Con <b>~$: ./obj/G-2313-07-P1 -t</b> se usa el modelo de un hilo por cliente</li></ul>
  * \subsection step3 Paso 3: Pruebas del Servidor
  * Ejecución pruebas r2d2 escribiendo el comando desde el directorio donde se encuentra el Makefile<br>
  * Se vera un listado con las pruebas que se van pasando y la calficacion obtenida
@@ -64,13 +68,21 @@
  * <p>Se incluyen las siguientes funciones de conexión y uso del servidor IRC:
  * <ul>
  * <li>@subpage IRC_Initiate_Server</li>
+ * <li>@subpage IRC_Open_Socket</li>
  * <li>@subpage IRC_Accept_Connection</li>
  * <li>@subpage IRC_New_Client</li>
  * <li>@subpage IRC_Server_Parser</li>
+ * <li>@subpage IRC_Server_Resume</li>
  * <li>@subpage IRC_Ping_Pong</li>
  * <li>@subpage IRC_End_Server</li>
+ * <li>@subpage IRC_Stop_Server</li>
  * </ul></p>
  *
+ * <p>El bucle de eventos se describe en @ref irc_reactor, la tabla de comandos y sus manejadores en
+ * @ref irc_commands, las respuestas en @ref irc_reply y las largas en @ref irc_cursor, el estado de cada conexion en @ref irc_session
+ * el indice de usuarios por nick en @ref irc_users, los miembros de cada canal en @ref irc_channels, la
+ * resolucion del host de los clientes en @ref irc_resolver y el registro de mensajes en @ref irc_log.</p>
+ *
  * <hr>
  * <hr>
  *
@@ -81,9 +93,20 @@
  */
 
 #include "../includes/G-2313-07-P1-server.h"
+#include "../includes/G-2313-07-P1-session.h"
+#include "../includes/G-2313-07-P1-reactor.h"
+#include "../includes/G-2313-07-P1-users.h"
+#include "../includes/G-2313-07-P1-channels.h"
+#include "../includes/G-2313-07-P1-resolver.h"
+#include "../includes/G-2313-07-P1-commands.h"
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-cursor.h"
+#include "../includes/G-2313-07-P1-welcome.h"
+#include "../includes/G-2313-07-P1-stats.h"
 
 int sockval = 0; /**< @brief Valor del descriptor del socket del Servidor */
-int in_register = 0;
+static atomic_int terminar = 0; /**< @brief SIGINT ha pedido terminar el servidor */
+static atomic_int saliendo = 0; /**< @brief Algun hilo ya esta terminando el servidor */
 
 /**
  * @page IRC_Initiate_Server IRC_Initiate_Server
@@ -97,11 +120,60 @@ int in_register = 0;
  * @endcode
  *
  * <h2>Descripción</h2>
+ * Abre el socket del servidor con IRC_Open_Socket.
+ *
+ * Además establece el manejador para la señal SIGINT e ignora SIGPIPE, para que un cliente que
+ * cierra mientras se le envia no tumbe el servidor entero, y lanza los hilos que resuelven el
+ * nombre de host de los clientes. Por ultimo prepara la bienvenida y el MOTD, que SIGHUP manda
+ * recargar.
+ *
+ * @retval int El descriptor del socket que acaba de abrir y preparar para escuchar concexiones.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+int IRC_Initiate_Server()
+{
+	sockval = IRC_Open_Socket();
+
+	/*Manejadores de señales*/
+	signal(SIGINT, IRC_End_Server);
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGHUP, IRC_Welcome_Signal);
+
+	IRC_Stats_Init();
+	IRC_Resolver_Init(RESOLVER_HILOS);
+	IRC_Commands_Init();
+	IRC_Welcome_Load();
+
+	return sockval;
+}
+
+/**
+ * @page IRC_Open_Socket IRC_Open_Socket
+ * @brief Abre un socket de escucha en el puerto del servidor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-server.h"
+ *
+ * int IRC_Open_Socket()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
  * Abre el socket y comprobando que no haya error, a continuacion hace bind y lo prepara para escuchar.
  * Escucha un máximo de conexiones. En caso de que alguno de estos pasos falle se reflejará en el log del
  * sistema.
  *
- * Además establece el manejador para la señal SIGINT
+ * El socket se abre con SO_REUSEPORT, de forma que cada reactor puede abrir el suyo en el mismo puerto
+ * y el kernel reparte entre ellos las conexiones entrantes.
  *
  * @retval int El descriptor del socket que acaba de abrir y preparar para escuchar concexiones.
  *
@@ -115,13 +187,20 @@ int in_register = 0;
  * <hr>
  *
  */
-int IRC_Initiate_Server()
+int IRC_Open_Socket()
 {
 	struct sockaddr_in Direccion;
+	int sock, activo = 1;
 
-	syslog(LOG_INFO, "Creating socket");
-	if ( (sockval = socket(AF_INET, SOCK_STREAM, 0)) < 0 ){
-		syslog(LOG_ERR, "Error creating socket");
+	IRC_Log(LOG_INFO, "Creating socket");
+	if ( (sock = socket(AF_INET, SOCK_STREAM, 0)) < 0 ){
+		IRC_Log(LOG_ERR, "Error creating socket");
+		exit(EXIT_FAILURE);
+	}
+
+	if (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &activo, sizeof(activo)) < 0 ||
+	    setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &activo, sizeof(activo)) < 0){
+		IRC_Log(LOG_ERR, "Error setting SO_REUSEPORT");
 		exit(EXIT_FAILURE);
 	}
 
@@ -130,23 +209,19 @@ int IRC_Initiate_Server()
 	Direccion.sin_addr.s_addr=htonl(INADDR_ANY); /* Accept all adresses */
 	bzero((void *)&(Direccion.sin_zero), 8);
 
-	syslog (LOG_INFO, "Binding socket");
-	if (bind (sockval, (struct sockaddr *)&Direccion, sizeof(Direccion))<0){
-		syslog(LOG_ERR, "Error binding socket");
+	IRC_Log(LOG_INFO, "Binding socket");
+	if (bind (sock, (struct sockaddr *)&Direccion, sizeof(Direccion))<0){
+		IRC_Log(LOG_ERR, "Error binding socket");
 		exit(EXIT_FAILURE);
 	}
 
-	syslog (LOG_INFO, "Listening connections");
-	if (listen (sockval, MAX_CONNECTIONS)<0){
-		syslog(LOG_ERR, "Error listenining");
+	IRC_Log(LOG_INFO, "Listening connections");
+	if (listen (sock, MAX_CONNECTIONS)<0){
+		IRC_Log(LOG_ERR, "Error listenining");
 		exit(EXIT_FAILURE);
 	}
 
-	/*Manejadores de señales*/
-	signal(SIGINT, IRC_End_Server);
-	signal(SIGALRM, IRC_Ping_Pong);
-
-	return sockval;
+	return sock;
 }
 
 /**
@@ -162,10 +237,11 @@ int IRC_Initiate_Server()
  *
  * <h2>Descripción</h2>
  *
- * Esta función se encarga de finalizar el servidor, por lo tanto se ocupa de liberar todos los recursos
- * que este usando el servidor en el momento de ser la lanzada la señal sig.
- * Ademas de hacer estas liberaciones cierra el socket en el que estaba abierto el servidor para dejarlo
- * libre para futuros usos.
+ * Manejador de SIGINT. Dentro de un manejador solo se puede llamar a funciones seguras frente a
+ * señales, asi que solo apunta que hay que terminar y despierta a quien tiene que hacerlo: escribe
+ * en el eventfd de cada reactor y cierra para lectura el socket del servidor, con lo que el accept
+ * del modelo de hilos falla. Las liberaciones y la salida las hace IRC_Stop_Server desde un hilo
+ * normal.
  *
  * @param[in] sig Valor de la señal a la que va a estar asociada esta funcion.
  *
@@ -180,17 +256,58 @@ int IRC_Initiate_Server()
  *
  */
 void IRC_End_Server(int sig)
+{
+	atomic_store(&terminar, 1);
+	IRC_Reactor_Wake();
+	shutdown(sockval, SHUT_RD);
+}
+
+/**
+ * @page IRC_Stop_Server IRC_Stop_Server
+ * @brief Finaliza y libera todos los recursos del servidor si se ha pedido terminar
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-server.h"
+ *
+ * void IRC_Stop_Server()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La llaman los reactores en cada vuelta y el bucle de IRC_Accept_Connection cuando falla accept.
+ * Si IRC_End_Server no ha apuntado que hay que terminar no hace nada. Si lo ha hecho, libera los
+ * recursos que este usando el servidor, cierra el socket en el que estaba abierto para dejarlo
+ * libre para futuros usos, vacia el registro y termina el proceso, con lo que paran todos los
+ * reactores. Si varios hilos la llaman a la vez solo termina uno.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Stop_Server()
 {
 	char ** users = NULL, **nicks = NULL, **realnames = NULL, **passwords = NULL, **hosts = NULL, **IPs = NULL;
 	long *creationTSs = NULL, *actionTSs = NULL, *ids = NULL, *modes = NULL;
 	int *sockets = NULL;
 	long nelements;
 
+	if(atomic_load(&terminar) == 0 || atomic_exchange(&saliendo, 1) == 1)
+		return;
+
 	IRCTADUser_GetAllLists(&nelements,&ids, &users, &nicks, &realnames, &passwords, &hosts, &IPs, &sockets, &modes, &creationTSs, &actionTSs);
 	IRCTADUser_FreeAllLists(nelements,ids,users, nicks, realnames, passwords, hosts, IPs, sockets, modes, creationTSs, actionTSs);
 
 	close(sockval);
-	syslog (LOG_INFO, "Exiting service");
+	IRC_Log(LOG_INFO, "Exiting service");
+	IRC_Log_Flush();
+	exit(EXIT_SUCCESS);
 }
 
 /**
@@ -207,8 +324,11 @@ void IRC_End_Server(int sig)
  * <h2>Descripción</h2>
  *
  * Esta función esta permanentemente a la espera de aceptar conexiones, cunado recibe una
- * nueva conexion crea un hilo para el cliente que acaba de llegar y manda a este hilo a la funcion
- * launch_service.
+ * nueva conexion crea su sesion y un hilo para el cliente que acaba de llegar, y manda a este hilo
+ * a la funcion IRC_New_Client.
+ *
+ * Es el modelo de un hilo por cliente, que se mantiene como alternativa al bucle de eventos
+ * de IRC_Reactor_Run para poder comparar ambos bajo la misma carga.
  *
  * @param[in] sockval Valor del descriptor del servidor obtenido al crear el socket.
  *
@@ -228,17 +348,28 @@ void IRC_Accept_Connection(int sockval)
 	struct sockaddr Conexion;
 	pthread_t hilo;
 	socklen_t len;
-	len = sizeof(Conexion);
+	Session *sesion;
 
 	while(1){
+		len = sizeof(Conexion);
 		if ((desc = accept(sockval, &Conexion, &len))<0){
-			syslog(LOG_ERR, "Error accepting connection");
+			IRC_Stop_Server();
+			IRC_Log(LOG_ERR, "Error accepting connection");
 			exit(EXIT_FAILURE);
 		}
-		syslog(LOG_INFO, "%d descriptor de usuario\n", desc);
+		IRC_Debug("%d descriptor de usuario\n", desc);
+
+		if((sesion = IRC_Session_New(desc)) == NULL){
+			close(desc);
+			continue;
+		}
 
 		/*Creamos el hilo para atender al cliente*/
-		pthread_create(&hilo, NULL, IRC_New_Client, (void*) &desc);
+		if(pthread_create(&hilo, NULL, IRC_New_Client, (void*) sesion) != 0){
+			IRC_Session_Free(sesion);
+			continue;
+		}
+		pthread_detach(hilo);
 	}
 	return;
 }
@@ -257,14 +388,16 @@ void IRC_Accept_Connection(int sockval)
  *
  * <h2>Descripción</h2>
  *
- * Esta función esta siempre esperando mensajes del cliente, los cuales dividira por si ha recibido
- * mas de un comando en el mismo mensaje, puesto que el maximo de IRC es 512 por cada mensaje.
- * A continuacion enviara este mensaje a parsear y ejecutar.
- * Adicionalmente esta función hace uso de otras para comprobar si el usuario ha cerrado conexión sin hacer QUIT
+ * Esta función esta siempre esperando mensajes del cliente. Lo recibido se acumula en el buffer de
+ * entrada de la sesion, que entrega las lineas completas aunque lleguen partidas en varios segmentos
+ * o varias en el mismo, y cada una se envia a parsear y ejecutar.
+ * El socket tiene un tiempo de espera de recepcion igual a lo que falta para el siguiente plazo de
+ * IRC_Ping_Pong, de modo que recv vuelve a tiempo de mandar el PING o de cerrar la conexion si el
+ * cliente no contesta o no se registra.
  *
- * @param[in] valor puntero void al descriptor del usuario
+ * @param[in] valor puntero void a la sesion del usuario
  *
- * @note Esta función se encarga de liberar la memoria reservada por el cliente.
+ * @note Esta función se encarga de liberar la sesion del cliente al terminar.
  *
  * <hr>
  *
@@ -278,44 +411,54 @@ void IRC_Accept_Connection(int sockval)
  */
 void *IRC_New_Client(void* valor)
 {
-	int connval = *((int *) valor);
-	char *str;
-	char mensaje[MAX_BUFFER];
+	Session *sesion = (Session *) valor;
+	int connval = sesion->desc;
 	char *command;
-	char *nick = NULL;
-	char *prefix_user = NULL;
+	long cerrar = FALSE, ahora, vence, espera_actual = 0;
+	ssize_t leidos;
+	struct timeval espera;
+
+	vence = IRC_Ping_Pong(sesion, sesion->creada);
+
+	while(cerrar == FALSE && vence >= 0){
+		/*Solo se cambia el tiempo de espera del socket cuando cambia el plazo*/
+		espera.tv_sec = vence - IRC_Timer_Now();
+		if(espera.tv_sec < 1)
+			espera.tv_sec = 1;
+		espera.tv_usec = 0;
+		if(espera.tv_sec != espera_actual){
+			setsockopt(connval, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+			espera_actual = espera.tv_sec;
+		}
 
-	while(1){
-		bzero(mensaje, MAX_BUFFER);
-		syslog (LOG_INFO, "Newping_pong access");
+		leidos = IRC_Framer_Read(&sesion->entrada, connval, 0);
+		ahora = IRC_Timer_Now();
+		if(leidos == 0)
+			break;
+		if(leidos < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			break;
 
-		if(isClosed(connval) == TRUE){
-			IRCTAD_Quit (nick);
-			close(connval);
-			free(nick);
-			free(prefix_user);
-			pthread_exit(NULL);
-		}
+		if(leidos > 0){
+			sesion->actividad = ahora;
+			sesion->ping = 0;
+			while (cerrar == FALSE && (command = IRC_Framer_Next(&sesion->entrada)) != NULL)
+				cerrar = IRC_Server_Parser(command, sesion);
 
-		recv(connval, (void*) mensaje, MAX_BUFFER, 0);
+			/*Un LIST o WHO largo se envia entero, send frena al hilo si el cliente no lee*/
+			while (cerrar == FALSE && IRC_Cursor_Step(sesion) == TRUE);
 
-		if(mensaje[0] == '\0'){
-			IRCTAD_Quit (nick);
-			close(connval);
-			free(nick);
-			free(prefix_user);
-			pthread_exit(NULL);
+			/*Este hilo es solo del cliente, puede esperar al DNS sin parar a nadie*/
+			if(cerrar == FALSE && sesion->estado == SESION_ESPERA){
+				IRC_Resolver_Wait(sesion);
+				IRC_Server_Resume(sesion);
+			}
 		}
 
-		str = IRC_UnPipelineCommands(mensaje, &command);
-		IRC_Server_Parser(command, connval, &nick, &prefix_user);
-		free(command);
-		while (str != NULL){
-			str = IRC_UnPipelineCommands(str, &command);
-			IRC_Server_Parser(command, connval, &nick, &prefix_user);
-			free(command);
-		}
+		vence = IRC_Ping_Pong(sesion, ahora);
 	}
+
+	IRC_Session_Free(sesion);
+	pthread_exit(NULL);
 }
 
 /**
@@ -325,17 +468,97 @@ void *IRC_New_Client(void* valor)
  * @code
  * #include "includes/G-2313-07-P1-server.h"
  *
- * void IRC_Ping_Pong(int sig)
+ * long IRC_Ping_Pong(Session *sesion, long ahora)
  * @endcode
  *
  * <h2>Descripción</h2>
  *
- * Esta funcion realiza el protocolo PING PONG, es decir, envía a cada usuario del servidor
- * un PING cada 30 segundos, y espera recibir de este un PONG, si no lo recibe es que el usuario ya no
- * esta conectado y por tanto lo elimina del servidor. De esta manera se optimiza el uso del servidor y de nicks
+ * Esta funcion realiza el protocolo PING PONG, es decir, envía un PING al usuario que lleva PING_INTERVALO
+ * segundos sin enviar nada, y espera recibir de este un PONG. Si en PONG_PLAZO segundos no llega nada es que
+ * el usuario ya no esta conectado y por tanto hay que eliminarlo del servidor. Tambien se elimina a quien no
+ * completa NICK y USER en REGISTRO_PLAZO segundos. Si ya tiene los dos y solo falta el DNS, al acabar
+ * RESOLVER_PLAZO se registra con la IP como host. De esta manera se optimiza el uso del servidor y de nicks
  * dejando solo conectados a aquellos que estan interactuando en el servidor.
  *
- * @param[in] sig Valor de la señal a la que va a estar asociada esta función.
+ * Cualquier cosa que envie el cliente cuenta como respuesta, quien lee del socket actualiza la actividad y
+ * borra el PING pendiente. La llaman los reactores al vencer el temporizador de la sesion y el modelo de hilos
+ * al volver recv por tiempo de espera.
+ *
+ * @param[in] sesion sesion del cliente
+ * @param[in] ahora segundo actual segun IRC_Timer_Now
+ *
+ * @retval long segundo en el que hay que volver a llamarla
+ * @retval -1 si hay que cerrar la conexion
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Ping_Pong (Session *sesion, long ahora)
+{
+	Buffer *buffer;
+
+	if(sesion->estado != SESION_REGISTRADA){
+		/*Solo falta el DNS, al acabar el plazo del resolvedor se registra con la IP*/
+		if(sesion->estado == SESION_ESPERA){
+			if(ahora - sesion->creada < RESOLVER_PLAZO)
+				return sesion->creada + RESOLVER_PLAZO;
+			IRC_Server_Resume(sesion);
+		}
+		if(sesion->estado == SESION_REGISTRADA)
+			return ahora + PING_INTERVALO;
+		if(ahora - sesion->creada >= REGISTRO_PLAZO){
+			IRC_Log(LOG_INFO, "Registration timeout on %d", sesion->desc);
+			return -1;
+		}
+		return sesion->creada + REGISTRO_PLAZO;
+	}
+
+	if(sesion->ping != 0){
+		if(ahora - sesion->ping >= PONG_PLAZO){
+			IRC_Log(LOG_INFO, "Ping timeout on %d", sesion->desc);
+			return -1;
+		}
+		return sesion->ping + PONG_PLAZO;
+	}
+
+	if(ahora - sesion->actividad < PING_INTERVALO)
+		return sesion->actividad + PING_INTERVALO;
+
+	if((buffer = IRC_Reply_Shared("PING :%s", SERVER)) != NULL){
+		IRC_Reactor_SendBuffer(sesion, buffer);
+		IRC_Buffer_Unref(buffer);
+	}
+	sesion->ping = ahora;
+
+	return ahora + PONG_PLAZO;
+}
+
+/**
+ * @page IRC_Server_Resume IRC_Server_Resume
+ * @brief Termina el registro que se aplazo a la espera del nombre del cliente
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-server.h"
+ *
+ * void IRC_Server_Resume(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * IRC_Server_Parser no espera al DNS: si la sesion ya tiene NICK y USER pero el resolvedor no tiene aun
+ * el host del cliente, se queda en SESION_ESPERA. Esta funcion la da de alta cuando el host ya es
+ * definitivo, o cuando ha pasado RESOLVER_PLAZO y se usa la IP. La llaman el reactor al recibir el aviso
+ * del resolvedor, IRC_Ping_Pong al acabar el plazo y el hilo del cliente en el modelo de hilos.
+ *
+ * @param[in] sesion sesion del cliente
  *
  * <hr>
  *
@@ -347,9 +570,14 @@ void *IRC_New_Client(void* valor)
  * <hr>
  *
  */
-void IRC_Ping_Pong (int sig)
+void IRC_Server_Resume(Session *sesion)
 {
-	/**/
+	if(sesion->estado != SESION_ESPERA)
+		return;
+
+	IRC_Resolver_Host(sesion);
+	sesion->resuelto = TRUE;
+	IRC_Commands_Register(sesion);
 }
 
 /**
@@ -360,32 +588,37 @@ void IRC_Ping_Pong (int sig)
  * @code
  * #include "includes/G-2313-07-P1-server.h"
  *
- * void IRC_Server_Parser(char* command, int desc, char** nick, char** prefix_user)
+ * long IRC_Server_Parser(char* command, Session *sesion)
  * @endcode
  *
  * <h2>Descripción</h2>
  *
- * Recibe una cadena con el comando que se quiere ejecutar, esta función se encarga de parsear este
- * comando y comprobar que esta correctamente formado. Si el comando pertenece a una caracteristica
- * no implementada en nuestro servidor se enviará un mensaje al descriptor de usuario recibido por parametro
- * indicando que dicho comando no esta implementado y es desconocido.
+ * Recibe una cadena con el comando que se quiere ejecutar, la separa una sola vez y sobre la propia linea
+ * en prefijo, verbo y parametros con IRC_Commands_Split y busca el verbo en la tabla de @ref irc_commands. Si el comando no
+ * esta implementado en nuestro servidor se responde ERR_UNKNOWNCOMMAND, y si le faltan parametros
+ * ERR_NEEDMOREPARAMS, sin llegar a su manejador.
  *
- * En caso de ser un comando conocido este se parseara, y según la información de este comando y el estado
- * del usario se procedera a ejecutar el comando y enviar al usuario un mensaje, indicando que se ha realizado
- * correctamente o incorrectamente.
+ * En caso de ser un comando conocido se llama a su manejador con el mensaje ya separado, que según la
+ * información de este comando y el estado del usario lo ejecuta y envia al usuario un mensaje, indicando
+ * que se ha realizado correctamente o incorrectamente.
  *
  * En algún caso el mensaje sera enviado a todos los usuarios del canal, como puede ser el caso de JOIN KICK PART
- * para informar de lo ocurrido a todos.
+ * para informar de lo ocurrido a todos. En ese caso el mensaje se genera una sola vez en un buffer compartido
+ * y a cada miembro solo se le encola una referencia.
+ *
+ * Hasta completar el registro solo se aceptan PASS, NICK, USER, PING, PONG y QUIT, al resto se responde
+ * ERR_NOTREGISTERED. NICK y USER pueden llegar en cualquier orden, cada uno apunta su parte en la sesion.
  *
  *
- * @param[in] command puntero a char con el comando recibido y que se va a parsear y ejecutar
- * @param[in] desc entero descriptor del usuario
- * @param[in,out] nick doble puntero char al nick del ususario
- * @param[in,out] prefix_user doble puntero char al prefix del usuario
+ * @param[in,out] command puntero a char con el comando recibido y que se va a parsear y ejecutar, se corta
+ * al separarlo
+ * @param[in,out] sesion sesion del cliente que envia el comando
  *
+ * @retval TRUE si el cliente ha hecho QUIT y hay que cerrar la conexion
+ * @retval FALSE si la conexion sigue abierta
  *
- * @warning Esta función realiza reservas en nick y prefix_user. Libera la memoria solo si se hace QUIT, si el cliente
- * se desconecta es el usuario quien tiene que liberar la memoria.
+ * @warning No cierra el socket ni libera la sesion al hacer QUIT, de eso se encarga quien la llama con
+ * IRC_Session_Free.
  *
  * <hr>
  *
@@ -397,890 +630,31 @@ void IRC_Ping_Pong (int sig)
  * <hr>
  *
  */
-void IRC_Server_Parser(char* command, int desc, char** nick, char** prefix_user)
+long IRC_Server_Parser(char* command, Session *sesion)
 {
-	char *prefix = NULL, *realname = NULL, *server = NULL, *modehost = NULL, *user = NULL, *target = NULL, *maskarray = NULL, *channel = NULL, *key = NULL;
-	char *msg = NULL, *password = NULL, *serverPing = NULL, *serverPong = NULL, *topic = NULL, *comment = NULL, *nick_pars = NULL, *topic_actual = NULL;
-	char **list = NULL;
-	char aux[MAX_BUFFER], mode[2], whoname[MAX_NICKNAME+2];
-	long nelements, creationTS, actionTS;
-	char *unknown_real = NULL, *unknown_nick = NULL, *unknown_user = NULL, *modo = NULL;
-	long unknown_id = 0;
-	char *host = NULL, *IP = NULL, *away = NULL, *names = NULL, *setpass = NULL, *mask = NULL, *oppar = NULL;
-	int i;
-	int sock = 0;
-
-	struct hostent *he;
-	socklen_t size_addres;
-	struct sockaddr_in addr;
-
-
-	/*Indexamos con el tipo de comando*/
-	switch(IRC_CommandQuery(command)){
-
-/************************************ PASS ****************************************************/
-		case PASS:
-			syslog(LOG_INFO, "CASE PASSS\n");
-			if(IRCParse_Pass (command, &prefix, &password) == IRC_OK){
-				syslog(LOG_INFO, "PARSEO PASS CORRECTO\n");
-			}
-			free(prefix);
-			free(password);
-			break;
-
-/************************************ NICK ****************************************************/
-		case NICK:
-			if(IRCParse_Nick(command, &prefix, &nick_pars, &msg) != IRC_OK){
-				syslog(LOG_INFO, "NICK => ERROR %s", nick_pars);
-				if(IRCMsg_ErrWasNoSuchNick (&msg, prefix, nick_pars, nick_pars) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-			}else if(strlen(nick_pars) > MAX_NICKNAME+1){
-				syslog(LOG_INFO, "Longitud maxima superada\n");
-				if(IRCMsg_ErrErroneusNickName(&msg, prefix, nick_pars, nick_pars) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-			}else if(exist_User(nick_pars) == TRUE){
-				syslog(LOG_INFO, "NICK %s => EN USO\n", *nick);
-				if(IRCMsg_ErrNickNameInUse(&msg, prefix , nick_pars, nick_pars) == IRC_OK){
-					send(desc,msg, strlen(msg), 0);
-					free(msg);
-				}
-
-			}else{
-				syslog(LOG_INFO, "CASE NICK => CORRECTO\n");
-				in_register = 1;
-
-				/*Regeneramos el prefix*/
-				if(*nick != NULL){
-
-					/* Obtiene todos los parámetros a partir del nick*/
-					switch (IRCTADUser_Set(unknown_id, unknown_user, *nick, unknown_real, unknown_user, nick_pars, unknown_real)) {
-
-						case IRCERR_NOENOUGHMEMORY:
-							syslog(LOG_INFO, "CASE NICK => IRCERR_NOENOUGHMEMORY\n");
-							break;
-
-						case IRCERR_NICKUSED:
-							syslog(LOG_INFO, "CASE NICK => IRCERR_NICKUSED\n");
-							break;
-
-						case IRCERR_INVALIDNICK:
-							syslog(LOG_INFO, "CASE NICK => IRCERR_INVALIDNICK\n");
-							break;
-
-						case IRCERR_INVALIDREALNAME:
-							syslog(LOG_INFO, "CASE NICK => IRCERR_INVALIDREALNAME\n");
-							break;
-
-						case IRCERR_INVALIDUSER:
-							syslog(LOG_INFO, "CASE NICK => IRCERR_INVALIDUSER\n");
-							break;
-
-						case IRC_OK:
-							user = NULL;
-
-							IRCTADUser_GetData (&unknown_id, &user, &unknown_nick, &unknown_real, &host, &IP, &desc, &creationTS, &actionTS, &away);
-
-							if(IRCMsg_Nick (&msg, *prefix_user+1, NULL, nick_pars) == IRC_OK){
-								send(desc,msg, strlen(msg), 0);
-								free(msg);
-							}
-
-							free(*prefix_user);
-							IRC_Prefix (&(*prefix_user), nick_pars, user, NULL, "LOCALHOST");
-							syslog(LOG_INFO, "PREFIX NUEVO %s", *prefix_user);
-
-							/*Avisar en todos los canales*/
-
-							free(*nick);
-							free(user);
-							free(unknown_nick);
-							free(unknown_real);
-							free(host);
-							free(IP);
-							free(away);
-							break;
-					}
-				}
-				*nick = (char *) malloc(strlen(nick_pars)+1); /*MIrando lo de eloy en metis*/
-				strcpy(*nick, nick_pars);
-
-			}
-			free(prefix);
-			free(nick_pars);
-
-			break;
-
-/************************************ USER ****************************************************/
-		case USER:
-			syslog(LOG_INFO, "CASE USER\n");
-			if (in_register == 1){
-				if(IRCParse_User (command, &prefix, &user, &modehost, &server, &realname) == IRC_OK){
-
-					size_addres = sizeof(addr);
-					getpeername(desc, (struct sockaddr *)&addr, &size_addres);
-					IP = inet_ntoa(addr.sin_addr);
-					he = gethostbyaddr((char *)&addr.sin_addr, sizeof(addr.sin_addr), AF_INET);
-
-					if(IRCTADUser_New(user, *nick, realname, NULL, he->h_name, IP, desc) == IRC_OK){
-
-						free(prefix);
-						IP = NULL;
-
-						IRCTADUser_GetData (&unknown_id, &user, &unknown_nick, &unknown_real, &host, &IP, &desc, &creationTS, &actionTS, &away);
-
-						IRC_Prefix (&(*prefix_user), *nick, user, NULL, "LOCALHOST");
-						syslog(LOG_INFO, "PREFIX NUEVO EN USER %s", *prefix_user);
-
-						free(unknown_nick);
-						free(unknown_real);
-						free(host);
-						free(IP);
-						free(away);
-					}
-
-					/* Mensaje de Bienvenida*/
-					if(IRCMsg_RplWelcome(&msg, *prefix_user+1, *nick, *nick, user, server) == IRC_OK){
-						send(desc, msg, strlen(msg), 0);
-						free(msg);
-					}
-					in_register = 0;
-
-					free(prefix);
-					free(user);
-					free(modehost);
-					free(server);
-					free(realname);
-				}
-			}
-			break;
-
-/************************************ JOIN ****************************************************/
-		case JOIN:
-			syslog(LOG_INFO, "CASE JOIN\n");
-			if(IRCParse_Join(command, &prefix, &channel, &key, &msg) == IRC_OK){
-				/*Comprobamos que empiece por #*/
-				if(channel[0] != '#') {
-          syslog(LOG_INFO, "CANAL INCORRECTO: %s", channel);
-					free(msg);
-					if(IRCMsg_ErrNoSuchChannel (&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-						send(desc, msg, strlen(msg), 0);
-						free(msg);
-					}
-					free(prefix);
-					free(channel);
-					free(key);
-					return;
-       	}
-
-				/*Si el canal no existe establecemos al usuario como operador*/
-				if(IRCTAD_TestUserOnChannel (channel, *nick) == IRCERR_NOVALIDCHANNEL){
-					strcpy(mode, "o");
-				}else{
-					strcpy(mode, "");
-				}
-
-				if((IRCTADChan_GetModeInt (channel) & IRCMODE_CHANNELPASSWORD ) == IRCMODE_CHANNELPASSWORD){
-					if(IRCTADChan_TestPassword (channel, key) != IRC_OK || key == NULL){
-						syslog(LOG_INFO, "PASS dont match\n");
-						free(msg);
-						if(IRCMsg_ErrBadChannelKey(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-
-						free(unknown_real);
-						free(host);
-						free(IP);
-						free(away);
-						free(user);
-						free(prefix);
-						free(channel);
-						free(key);
-						return;
-					}
-				}
-
-				free(prefix);
-
-				switch (IRCTAD_Join (channel, *nick, mode, key)) {
-
-					case IRCERR_NOVALIDUSER: /*no existe el usuario indicado*/
-						if(IRCMsg_ErrNoLogin(&msg, *prefix_user+1, *nick, user) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_NOVALIDCHANNEL: /*el canal indicado no es valido*/
-						if(IRCMsg_ErrNoSuchChannel(&msg, *prefix_user+1, *nick, channel) ==  IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_USERSLIMITEXCEEDED: /*no se admiten mas usuarios en el canal*/
-						if(IRCMsg_ErrChannelIsFull(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_NOENOUGHMEMORY: /*no hay suficiente memoria para crear el canal*/
-						break;
-
-					case IRCERR_BANEDUSERONCHANNEL: /*no puede unirse por estar baneado*/
-						if(IRCMsg_ErrBannedFromChan(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_NOINVITEDUSER: /*canal con invitacion y no ha sido invitado*/
-						if(IRCMsg_ErrInviteOnlyChan(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_YETINCHANNEL: /*user distinto, mismo nick*/
-						break;
-
-					case IRC_OK: /*se ha anadido el usuario al canal*/
-						syslog(LOG_INFO, "JOIN CORRECTO");
-
-						free(prefix);
-
-						IRCTAD_ListNicksOnChannelArray(channel, &list, &nelements);
-						for(i=0; i<nelements; i++){
-							if(IRCTADUser_GetData (&unknown_id, &user, &list[i], &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-								if(IRCMsg_Join (&msg, *prefix_user+1, NULL, NULL, channel) == IRC_OK){
-									send(sock, msg, strlen(msg), 0);
-									free(msg);
-								}
-								free(unknown_real);
-								free(host);
-								free(IP);
-								free(away);
-								free(user);
-								unknown_real = host = IP = away = user = NULL;
-								unknown_id=0;
-								sock=0;
-							}
-						}
-						IRCTADUser_FreeList (list, nelements);
-
-						break;
-				}
-			}else{ /*Parseo no fue IRC_OK*/
-				free(msg);
-				if(IRCMsg_ErrNeedMoreParams(&msg, *prefix_user+1 , *nick, command) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-			}
-			free(prefix);
-			free(channel);
-			free(key);
-			break;
-
-/************************************ LIST ****************************************************/
-		case LIST:
-			syslog(LOG_INFO, "CASE LIST\n");
-			if(IRCParse_List (command, &prefix, &channel, &target) == IRC_OK){
-
-				if(IRCMsg_RplListStart(&msg, *prefix_user+1, *nick) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				if(IRCTADChan_GetList(&list, &nelements, NULL) == IRC_OK){
-					for(i=0; i < nelements; i++){
-						if(IRCTADChan_GetModeInt(list[i]) != IRCMODE_SECRET){
-							 if(IRCTAD_GetTopic(list[i], &topic) == IRC_OK){
-								 sprintf(aux, "%ld", IRCTADChan_GetNumberOfUsers(list[i]));
-								 syslog(LOG_INFO, "%s aux", aux);
-								 if(IRCMsg_RplList(&msg, *prefix_user+1, *nick, list[i], aux, topic) == IRC_OK){
-									 send(desc, msg, strlen(msg), 0);
-									 free(msg);
-								 }
-							 }
-						 }
-					 }
-				 }
-
-				if(IRCMsg_RplListEnd(&msg, *prefix_user+1, *nick) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				IRCTADChan_FreeList (list, nelements);
-				free(channel);
-				free(prefix);
-				free(target);
-			}
-			break;
-
-/************************************ NAMES ***************************************************/
-		case NAMES:
-			syslog(LOG_INFO, "CASE NAMES\n");
-			if(IRCParse_Names (command, &prefix, &channel, &target) == IRC_OK){
-
-				free(target);
-				/*Names del canal indicado*/
-				if(channel != NULL){
-
-					if(IRCTAD_ListNicksOnChannelArray(channel, &list, &nelements) == IRC_OK){
-						names = (char *) malloc(nelements*(MAX_NICKNAME+1) * sizeof(char));
-						strcpy(names, "");
-
-						for(i = 0; i<nelements; i++){
-							if(i > 0){
-								strcat(names, " ");
-							}
-							if((IRCTAD_GetUserModeOnChannel (channel, list[i]) & IRCUMODE_OPERATOR) == IRCUMODE_OPERATOR){
-								strcat(names, "@");
-							}
-							strcat(names, list[i]);
-						}
-
-						IRCTADChan_FreeList (list, nelements);
-
-						if(IRCMsg_RplNamReply (&msg, *prefix_user+1, *nick, "=", channel, names) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-
-						free(names);
-					}
-
-
-				}else{/*Names de todos los canles del servidor*/
-
-				}
-
-				if(IRCMsg_RplEndOfNames (&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				free(prefix);
-				free(channel);
-				free(target);
-			}
-
-			break;
-
-/************************************* WHO ****************************************************/
-		case WHO:
-			syslog(LOG_INFO, "CASE WHO\n");
-			if(IRCParse_Who (command, &prefix, &mask, &oppar) == IRC_OK){
-
-				if(mask == NULL){
-					free(prefix);
-					free(oppar);
-				}else{
-					if(IRCTAD_ListNicksOnChannelArray(mask, &list, &nelements) == IRC_OK){
-						for(i=0; i<nelements; i++){
-							if(IRCTADUser_GetData (&unknown_id, &user, &list[i], &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-								sprintf(whoname, "~%s", user);
-								if(IRCMsg_RplWhoReply (&msg, SERVER, *nick, mask, whoname, IP, SERVER, list[i] , "H", 0, unknown_real) == IRC_OK){
-										send(desc, msg, strlen(msg), 0);
-										free(msg);
-								}
-								free(unknown_real);
-								free(host);
-								free(IP);
-								free(away);
-								free(user);
-								unknown_real = host = IP = away = user = NULL;
-								unknown_id=0;
-								sock=0;
-							}
-						}
-						IRCTADUser_FreeList (list, nelements);
-					}
-
-
-					if(IRCMsg_RplEndOfWho (&msg, SERVER, *nick, mask) == IRC_OK){
-						send(desc, msg, strlen(msg), 0);
-						free(msg);
-					}
-
-					free(prefix);
-					free(mask);
-					free(oppar);
-				}
-			}
-
-			break;
-
-/************************************ WHOIS ***************************************************/
-		case WHOIS:
-			syslog(LOG_INFO, "CASE WHOIS\n");
-			if(IRCParse_Whois(command, &prefix, &target, &maskarray) == IRC_OK){
-
-				if(IRCTADUser_GetData (&unknown_id, &user, nick, &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-
-					if(away != NULL){
-						if(IRCMsg_RplAway (&msg, *prefix_user+1, *nick, *nick, away) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-					}else	if(IRCTAD_ListChannelsOfUserArray (user, *nick, &list, &nelements) == IRC_OK){
-						names = (char*)malloc(nelements * MAX_CHANNELNAME * sizeof(char));
-						strcpy(names, "");
-
-						for(i=0; i<nelements; i++){
-							if(i > 0){
-								strcat(names, " ");
-							}
-							if((IRCTAD_GetUserModeOnChannel (list[i], *nick) & IRCUMODE_OPERATOR) == IRCUMODE_OPERATOR){
-								strcat(names, "@");
-							}
-							strcat(names, list[i]);
-						}
-
-						if(IRCMsg_RplWhoIsChannels (&msg, *prefix_user+1, *nick, *nick, names) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-
-						if(IRCMsg_RplEndOfWhoIs (&msg, *prefix_user+1, *nick, *nick) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-
-						free(names);
-						IRCTADChan_FreeList (list, nelements);
-					}
-					free(user);
-					free(unknown_real);
-					free(host);
-					free(IP);
-					free(away);
-				}
-
-			}else{
-				if(IRCMsg_ErrNoNickNameGiven(&msg, *prefix_user+1, *nick) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-			}
-			free(prefix);
-			free(target);
-			free(maskarray);
-
-			break;
-
-/************************************ PING ****************************************************/
-		case PING:
-			syslog(LOG_INFO, "CASE PING\n");
-			if(IRCParse_Ping (command, &prefix, &serverPing, &serverPong, &msg) == IRC_OK){
-				if(IRCMsg_Pong (&msg, *prefix_user+1, serverPing, serverPong, serverPing) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-			}
-			free(prefix);
-			free(serverPing);
-			free(serverPong);
-			break;
-
-/************************************ PRIVMSG **************************************************/
-		case PRIVMSG: /*Segundo*/
-			syslog(LOG_INFO, "CASE PRIVMSG\n");
-			if(IRCParse_Privmsg (command, &prefix, &target, &msg) == IRC_OK){
-
-				/*CASO MENSAJE EN CANAL*/
-				if(target[0] == '#') {
-					switch (IRCTAD_ListNicksOnChannelArray(target, &list, &nelements)) {
-
-						case IRCERR_NOENOUGHMEMORY:
-							break;
-
-						case IRCERR_NOVALIDCHANNEL:
-							free(msg);
-							if(IRCMsg_ErrNoSuchChannel(&msg, *prefix_user+1, *nick, channel) ==  IRC_OK){
-								send(desc, msg, strlen(msg), 0);
-								free(msg);
-							}
-							break;
-
-						case IRC_OK:
-							for(i=0; i<nelements; i++){
-								if(strcmp((*nick), list[i]) != 0){
-									if(IRCTADUser_GetData (&unknown_id, &unknown_user, &list[i], &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-										if(away == NULL){
-											if(IRCMsg_Privmsg (&comment, *prefix_user+1, target, msg) ==  IRC_OK){
-												send(sock, comment, strlen(comment), 0);
-												free(comment);
-											}
-										}
-										free(unknown_user);
-										free(unknown_real);
-										free(host);
-										free(IP);
-										free(away);
-										unknown_id = 0;
-										sock = 0;
-										unknown_user = unknown_real = host = IP = away = NULL;
-									}
-								}
-							}
-							free(msg);
-							break;
-
-					}/*Fin del siwtch listnicksonchanel array*/
-					IRCTADUser_FreeList (list, nelements);
-
-        }else{
-					/*CASO MENSAJE PRIVADO A USUARIO*/
-					if(exist_User(target) == FALSE){
-						free(msg);
-						if(IRCMsg_ErrNoSuchNick(&msg, *prefix_user+1, *nick, target) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-					}else{ /*caso el usuario existe*/
-						if(IRCTADUser_GetData (&unknown_id, &unknown_user, &target, &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-							if(away != NULL){
-								free(msg);
-								if(IRCMsg_RplAway (&msg, *prefix_user+1, *nick, *nick, away) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}else if(IRCMsg_Privmsg (&comment, *prefix_user+1, target, msg) ==  IRC_OK){
-								send(sock, comment, strlen(comment), 0);
-								free(comment);
-								free(msg);
-							}
-							free(unknown_user);
-							free(unknown_real);
-							free(host);
-							free(IP);
-							free(away);
-						}
-					}
-				}
-			}
-
-			free(target);
-			free(prefix);
-
-
-			break;
-
-/************************************ PART ****************************************************/
-		case PART: /*Abandonar canal*/
-			syslog(LOG_INFO, "CASE PART\n");
-			if(IRCParse_Part (command, &prefix, &channel, &msg) == IRC_OK){
-				free(msg);
-				switch (IRCTAD_Part (channel, *nick)) {
-
-					case IRCERR_NOVALIDUSER: /*No existe el usuario en el canal*/
-						if(IRCMsg_ErrNoLogin(&msg, *prefix_user+1, *nick, user) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_NOVALIDCHANNEL: /*No existe el canal indicado*/
-						if(IRCMsg_ErrNoSuchChannel(&msg, *prefix_user+1, *nick, channel) ==  IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-						break;
-
-					case IRCERR_UNDELETABLECHANNEL: /*No se puede eliminar el canal porque es permanente*/
-						break;
-
-					case IRC_OK:
-						if(IRCTAD_ListNicksOnChannelArray(channel, &list, &nelements) == IRC_OK){
-							for(i=0; i<nelements; i++){
-								if(IRCTADUser_GetData (&unknown_id, &user, &list[i], &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-									if(IRCMsg_Part(&msg, *prefix_user+1, channel, "Hasta Nunki") ==  IRC_OK){
-										send(sock, msg, strlen(msg), 0);
-										free(msg);
-									}
-									free(unknown_real);
-									free(host);
-									free(IP);
-									free(away);
-									free(user);
-									unknown_real = host = IP = away = user = NULL;
-									unknown_id=0;
-									sock=0;
-								}
-							}
-							IRCTADUser_FreeList (list, nelements);
-						}
-
-						if(IRCMsg_Part(&msg, *prefix_user+1, channel, "Hasta Nunki") ==  IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-
-						break;
-				}
-			}
-			free(prefix);
-			free(channel);
-			break;
-
-/************************************ TOPIC ***************************************************/
-		case TOPIC:
-			syslog(LOG_INFO, "TOPIC\n");
-			if(IRCParse_Topic (command, &prefix, &channel, &topic) == IRC_OK){
-
-				/*Comprobamos si el canal tiene topic*/
-				if(IRCTAD_GetTopic (channel, &topic_actual) ==  IRC_OK){
-
-					if(topic == NULL && topic_actual == NULL){
-						if(IRCMsg_RplNoTopic(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-					}else if (topic == NULL && topic_actual != NULL){
-						if(IRCMsg_RplTopic(&msg, *prefix_user+1, *nick, channel, topic_actual) == IRC_OK){
-							send(desc, msg, strlen(msg), 0);
-							free(msg);
-						}
-					}else{
-						/*Primero comprobamos el modo que tiene el canal*/
-						if((IRCTADChan_GetModeInt (channel) & IRCMODE_TOPICOP) == IRCMODE_TOPICOP){
-							if(IRCMsg_ErrChanOPrivsNeeded(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-								send(desc, msg, strlen(msg), 0);
-								free(msg);
-							}
-						}else{
-							if(IRCTAD_SetTopic (channel, *nick, topic) == IRC_OK){
-								if(IRCMsg_Topic (&msg, *prefix_user+1, channel, topic) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}
-						}
-					}
-					free(topic_actual);
-				}
-				free(channel);
-				free(topic);
-				free(prefix);
-			}
-
-			break;
-
-/************************************ MODE ****************************************************/
-		case MODE:
-			syslog(LOG_INFO, "CASE MODE\n");
-			if(IRCParse_Mode (command, &prefix, &channel, &modo, &user) == IRC_OK){
-
-				if((IRCTAD_GetUserModeOnChannel (channel, *nick) & IRCUMODE_OPERATOR) != IRCUMODE_OPERATOR){
-					if(IRCMsg_ErrChanOPrivsNeeded(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-						send(desc, msg, strlen(msg), 0);
-						free(msg);
-					}
-				}else{
-					if(modo != NULL){
-						if(strcmp(modo, "\\+k") == 0){
-							setpass = (char*) malloc(sizeof(user) + 9);
-							strcpy(setpass, "");
-							strcat(setpass, "+k ");
-							strcat(setpass, user);
-
-							if(IRCTAD_Mode (channel, *nick, setpass) == IRC_OK){
-								if(IRCMsg_Mode (&msg, *prefix_user+1, channel, setpass, user) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}
-							free(setpass);
-						}else{
-							if(IRCTAD_Mode (channel, *nick, modo) == IRC_OK){
-								if(IRCMsg_Mode (&msg, *prefix_user+1, channel, modo, user) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}
-						}
-					}
-				}
-				free(prefix);
-				free(channel);
-				free(modo);
-				free(user);
-			}
-
-			break;
-
-/************************************ KICK ****************************************************/
-		case KICK:
-			syslog(LOG_INFO, "CASE KICK\n");
-
-			if(IRCParse_Kick (command, &prefix, &channel, &user, &comment) == IRC_OK){
-
-				if((IRCTAD_GetUserModeOnChannel (channel, *nick) & IRCUMODE_OPERATOR) != IRCUMODE_OPERATOR){
-					if(IRCMsg_ErrChanOPrivsNeeded(&msg, *prefix_user+1, *nick, channel) == IRC_OK){
-						send(desc, msg, strlen(msg), 0);
-						free(msg);
-					}
-				}else{
-					switch (IRCTAD_KickUserFromChannel (channel, user)) {
-						case IRCERR_NOVALIDUSER:
-							if(IRCMsg_ErrNoLogin(&msg, *prefix_user+1, *nick, user) == IRC_OK){
-								send(desc, msg, strlen(msg), 0);
-								free(msg);
-							}
-							break;
-
-						case IRCERR_NOVALIDCHANNEL:  /*el canal indicado no es valido*/
-							if(IRCMsg_ErrNoSuchChannel(&msg, *prefix_user+1, *nick, channel) ==  IRC_OK){
-								send(desc, msg, strlen(msg), 0);
-								free(msg);
-							}
-							break;
-
-						case IRCERR_UNDELETABLECHANNEL:
-							break;
-
-						case IRC_OK:
-							/*Notificacamos a todos los usuarios del canal de quien fue expulsado*/
-							if(IRCTAD_ListNicksOnChannelArray(channel, &list, &nelements) == IRC_OK){
-								for(i=0; i<nelements; i++){
-									if(IRCTADUser_GetData (&unknown_id, &unknown_user, &list[i], &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-										if(IRCMsg_Kick (&msg, *prefix_user+1, channel, user, comment) == IRC_OK){
-											send(sock, msg, strlen(msg), 0);
-											free(msg);
-										}
-										free(unknown_real);
-										free(host);
-										free(IP);
-										free(away);
-										free(unknown_user);
-										unknown_real = host = IP = away = unknown_user = NULL;
-										unknown_id=0;
-										sock=0;
-									}
-								}
-								IRCTADUser_FreeList (list, nelements);
-							}
-
-							/*Notificacamos al usuario su expulsión*/
-							IRCTADUser_GetData (&unknown_id, &unknown_user, &user, &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away);
-							if(IRCMsg_Kick (&msg, *prefix_user+1, channel, user, comment) == IRC_OK){
-								send(sock, msg, strlen(msg), 0);
-								free(msg);
-							}
-							free(unknown_user);
-							free(unknown_real);
-							free(host);
-							free(IP);
-							free(away);
-							break;
-					}
-				}
-				free(prefix);
-				free(channel);
-				free(user);
-				free(comment);
-			}
-			break;
-
-/************************************ AWAY ****************************************************/
-		case AWAY:
-			syslog(LOG_INFO, "CASE AWAY");
-			if(IRCParse_Away (command, &prefix, &comment) == IRC_OK){
-					if(IRCTADUser_GetData (&unknown_id, &unknown_user, nick, &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-						if(IRCTADUser_SetAway (unknown_id, unknown_user, *nick, unknown_real, comment) == IRC_OK){
-							if(comment != NULL){
-								if(IRCMsg_RplNowAway (&msg, *prefix_user+1, *nick) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}else{
-								if(IRCMsg_RplUnaway (&msg, *prefix_user+1, *nick) == IRC_OK){
-									send(desc, msg, strlen(msg), 0);
-									free(msg);
-								}
-							}
-						}
-						free(unknown_user);
-						free(unknown_real);
-						free(host);
-						free(IP);
-						free(away);
-					}
-				free(prefix);
-				free(comment);
-			}
-			break;
-
-/************************************ QUIT ****************************************************/
-		case QUIT:
-			syslog(LOG_INFO, "CASE QUIT\n");
-			if(IRCParse_Quit(command, &prefix, &comment) != IRC_OK){
-				syslog(LOG_INFO, "Error en Quit\n");
-				free(prefix);
-				free(comment);
-			}else{
-
-				/*Si sale y no estaba resgistrado*/
-				if(exist_descriptor(&desc) == FALSE)
-					pthread_exit(NULL);
-
-				IRCTAD_Quit (*nick);
-
-				if(IRCMsg_Quit (&msg, *prefix_user+1, comment) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				close(desc);
-
-				free(prefix);
-				free(comment);
-				free(*nick);
-				free(*prefix_user);
-				pthread_exit(NULL);
-			}
-			break;
-/************************************ MOTD ****************************************************/
-		case MOTD:
-			syslog(LOG_INFO, "MOTD\n");
-			if(IRCParse_Motd (command, &prefix, &target) == IRC_OK){
-
-				if(IRCMsg_RplMotdStart(&msg, *prefix_user+1, *nick, SERVER) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				if(IRCMsg_RplMotd(&msg, *prefix_user+1, *nick, SERVER) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				if(IRCMsg_RplEndOfMotd(&msg, *prefix_user+1, *nick) == IRC_OK){
-					send(desc, msg, strlen(msg), 0);
-					free(msg);
-				}
-
-				free(prefix);
-				free(target);
-			}
-
-			break;
-
-		default:
-			syslog(LOG_INFO, "OPCION NO IMPLEMENTADA %ld\n", IRC_CommandQuery(command));
-
-			if(IRCMsg_ErrUnKnownCommand(&msg, *prefix_user+1, *nick, command) == IRC_OK){
-				send(desc, msg, strlen(msg), 0);
-				free(msg);
-			}
-			break;
+	Mensaje mensaje;
+	const Comando *comando;
+	long ret = FALSE;
+
+	if(IRC_Commands_Split(command, &mensaje) == FALSE)
+		return FALSE;
+
+	/*Todo lo que responda el comando sale en un solo buffer al terminar*/
+	IRC_Reply_Begin(sesion);
+	if((comando = IRC_Commands_Find(mensaje.verbo.texto)) == NULL){
+		IRC_Debug("OPCION NO IMPLEMENTADA %s\n", mensaje.verbo.texto);
+		IRC_Reply_ErrUnknownCommand(mensaje.verbo.texto);
+	}else if(comando->registro == TRUE && sesion->estado != SESION_REGISTRADA){
+		/*Sin registrar solo se atienden los comandos del registro*/
+		IRC_Reply_ErrNotRegistered();
+	}else if(mensaje.nparams < comando->min){
+		IRC_Reply_ErrNeedMoreParams(mensaje.verbo.texto);
+	}else{
+		if(mensaje.nparams > comando->max)
+			mensaje.nparams = comando->max;
+		ret = comando->manejador(sesion, &mensaje);
 	}
+	IRC_Reply_End();
+
+	return ret;
 }
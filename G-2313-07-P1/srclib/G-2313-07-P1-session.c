@@ -0,0 +1,209 @@
+/**
+* @brief Funciones de gestion del estado de cada conexion de cliente
+* @file G-2313-07-P1-session.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-session.h"
+#include "../includes/G-2313-07-P1-users.h"
+#include "../includes/G-2313-07-P1-channels.h"
+#include "../includes/G-2313-07-P1-resolver.h"
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-stats.h"
+
+static atomic_long siguiente_id = 0; /*!<Ultimo identificador de sesion asignado*/
+static Session *libres = NULL;       /*!<Sesiones del pool sin usar*/
+static pthread_mutex_t pool = PTHREAD_MUTEX_INITIALIZER; /*!<Protege la lista de libres*/
+
+/*! @page irc_session Sesiones de cliente
+*
+* <p>Esta sección incluye las funciones que crean y destruyen el estado asociado a cada
+* conexion de cliente. Tanto el modelo de un hilo por cliente como el bucle de eventos
+* trabajan sobre una sesion por conexion.</p>
+*
+* <p>La sesion lleva dentro todo lo del cliente: el estado del registro, el nick, el user
+* y el prefijo ya compuesto en cadenas de tamaño fijo, sus canales y sus buffers de entrada
+* y salida. Los manejadores reciben la sesion y no reservan ni liberan nada para saber quien
+* es el cliente. Las sesiones salen de un pool que se amplia de SESSION_SLAB en SESSION_SLAB
+* y al cerrar vuelven a el, asi las conexiones cortas no pasan por malloc.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-session.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Session_New</li>
+* <li>@subpage IRC_Session_Free</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+/*Saca una sesion del pool, reservando SESSION_SLAB de golpe si no quedan*/
+static Session *IRC_Session_Alloc()
+{
+	Session *sesion, *bloque;
+	int i;
+
+	pthread_mutex_lock(&pool);
+	if(libres == NULL){
+		bloque = (Session *) malloc(SESSION_SLAB * sizeof(Session));
+		if(bloque == NULL){
+			pthread_mutex_unlock(&pool);
+			return NULL;
+		}
+		for(i = 0; i < SESSION_SLAB; i++){
+			bloque[i].sig_pendiente = libres;
+			libres = &bloque[i];
+		}
+	}
+	sesion = libres;
+	libres = sesion->sig_pendiente;
+	pthread_mutex_unlock(&pool);
+
+	return sesion;
+}
+
+/**
+ * @page IRC_Session_New IRC_Session_New
+ * @brief Crea la sesion asociada a una conexion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-session.h"
+ *
+ * Session *IRC_Session_New(int desc)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Saca una sesion del pool para el descriptor recien aceptado, la da de alta en el indice por
+ * descriptor y empieza a resolver su nombre de host. La sesion empieza en SESION_NUEVA, con el
+ * nick y el prefijo vacios hasta que el cliente se registra con NICK y USER.
+ *
+ * @param[in] desc descriptor del socket del cliente
+ *
+ * @retval Session* la sesion creada
+ * @retval NULL en caso de error al reservar memoria
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Session *IRC_Session_New(int desc)
+{
+	Session *sesion;
+
+	if((sesion = IRC_Session_Alloc()) == NULL){
+		IRC_Log(LOG_ERR, "Error allocating session for %d", desc);
+		return NULL;
+	}
+
+	sesion->desc = desc;
+	sesion->id = atomic_fetch_add_explicit(&siguiente_id, 1, memory_order_relaxed) + 1;
+	sesion->estado = SESION_NUEVA;
+	sesion->nick[0] = '\0';
+	sesion->user[0] = '\0';
+	sesion->realname[0] = '\0';
+	sesion->prefix[0] = '\0';
+	sesion->away = NULL;
+	sesion->ncanales = 0;
+	sesion->marca = 0;
+	sesion->temporizador.sig = sesion->temporizador.ant = NULL;
+	sesion->temporizador.dueno = sesion;
+	sesion->creada = sesion->actividad = IRC_Timer_Now();
+	sesion->ping = 0;
+	IRC_Framer_Init(&sesion->entrada);
+	IRC_SendQ_Init(&sesion->salida);
+	sesion->cursor.tipo = CURSOR_NINGUNO;
+	sesion->cerrar = FALSE;
+	sesion->pendiente = FALSE;
+	sesion->sig_pendiente = NULL;
+
+	IRC_Users_Connect(sesion);
+	IRC_Resolver_Start(sesion);
+	IRC_Stats_Add(STATS_DESCONOCIDAS, 1);
+
+	return sesion;
+}
+
+/**
+ * @page IRC_Session_Free IRC_Session_Free
+ * @brief Cierra la conexion y libera la sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-session.h"
+ *
+ * void IRC_Session_Free(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Saca la sesion de sus canales avisando con un QUIT a quienes estaban con ella, si no lo ha hecho ya el comando QUIT,
+ * y del indice de usuarios, da de baja al usuario en el TAD si llego a registrarse, cierra el socket,
+ * libera la cola de salida y devuelve la sesion al pool. Se usa tanto cuando el cliente hace QUIT como cuando
+ * se marcha sin avisar.
+ *
+ * @param[in] sesion puntero a la sesion que se quiere liberar
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Session_Free(Session *sesion)
+{
+	Buffer *aviso = NULL;
+
+	if(sesion == NULL)
+		return;
+
+	/*Los canales solo los añade el propio cliente, si aqui no tiene ninguno ya no puede tenerlos*/
+	if(sesion->estado == SESION_REGISTRADA && sesion->ncanales > 0)
+		aviso = IRC_Reply_Shared("%s QUIT :Connection closed", sesion->prefix);
+	IRC_Channels_Quit(sesion, aviso);
+	IRC_Buffer_Unref(aviso);
+	IRC_Users_Remove(sesion);
+
+	if(sesion->estado == SESION_REGISTRADA){
+		IRCTAD_Quit(sesion->nick);
+		IRC_Stats_Add(STATS_USUARIOS, -1);
+	}else{
+		IRC_Stats_Add(STATS_DESCONOCIDAS, -1);
+	}
+
+	close(sesion->desc);
+	IRC_SendQ_Free(&sesion->salida);
+	free(sesion->away);
+
+	pthread_mutex_lock(&pool);
+	sesion->sig_pendiente = libres;
+	libres = sesion;
+	pthread_mutex_unlock(&pool);
+}
@@ -0,0 +1,261 @@
+/**
+* @brief Contadores del servidor para LUSERS
+* @file G-2313-07-P1-stats.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-stats.h"
+#include "../includes/G-2313-07-P1-reply.h"
+
+/*! @page irc_stats Contadores del servidor
+*
+* <p>Esta sección incluye los contadores con los que se responde LUSERS: usuarios, invisibles,
+* operadores, conexiones sin registrar y canales. LUSERS lo pide cada cliente al conectarse, asi
+* que responderlo no recorre usuarios ni canales.</p>
+*
+* <p>Cada hilo, es decir cada reactor en el modelo de eventos, tiene sus propios contadores
+* y les suma lo que pasa en las sesiones que atiende: el registro, la creacion y el borrado de
+* canales y las desconexiones. Solo ese hilo los escribe, asi que no compiten por la misma linea
+* de cache, y leer un contador es sumar los de todos los hilos sin cerrojos. Un contador de un
+* hilo puede quedar negativo, por ejemplo si la sesion se registro en un hilo y se cierra en otro,
+* pero la suma siempre es correcta.<br>
+* Como en los anillos de @ref irc_log, los contadores de los hilos que terminan los coge el
+* siguiente hilo que empieza, con sus valores, de modo que no se pierde nada.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-stats.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Stats_Init</li>
+* <li>@subpage IRC_Stats_Add</li>
+* <li>@subpage IRC_Stats_Get</li>
+* <li>@subpage IRC_Stats_Lusers</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static Contadores * _Atomic lista = NULL;          /*!<Contadores de todos los hilos, solo crece*/
+static _Thread_local Contadores *propios = NULL;   /*!<Contadores del hilo en curso*/
+static pthread_key_t clave;                        /*!<Para soltar los contadores cuando termina el hilo*/
+static atomic_long maximo = 0;                     /*!<Mas usuarios registrados a la vez*/
+
+
+/*Deja los contadores del hilo que termina para que los use otro*/
+static void IRC_Stats_Release(void *arg)
+{
+	atomic_store_explicit(&((Contadores *) arg)->libre, 1, memory_order_release);
+}
+
+/*Contadores del hilo en curso, cogiendo unos libres o creandolos la primera vez*/
+static Contadores *IRC_Stats_Own()
+{
+	Contadores *contadores;
+	int libre, i;
+
+	if(propios != NULL)
+		return propios;
+
+	for(contadores = atomic_load(&lista); contadores != NULL; contadores = contadores->sig){
+		libre = 1;
+		if(atomic_compare_exchange_strong(&contadores->libre, &libre, 0))
+			break;
+	}
+
+	if(contadores == NULL){
+		if((contadores = (Contadores *) malloc(sizeof(Contadores))) == NULL)
+			return NULL;
+		for(i = 0; i < STATS_CONTADORES; i++)
+			atomic_init(&contadores->valor[i], 0);
+		atomic_init(&contadores->libre, 0);
+		contadores->sig = atomic_load(&lista);
+		while(!atomic_compare_exchange_weak(&lista, &contadores->sig, contadores));
+	}
+
+	pthread_setspecific(clave, contadores);
+	propios = contadores;
+
+	return contadores;
+}
+
+/**
+ * @page IRC_Stats_Init IRC_Stats_Init
+ * @brief Prepara los contadores
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-stats.h"
+ *
+ * void IRC_Stats_Init()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Crea la clave de hilo con la que los contadores de un hilo que termina quedan libres para el
+ * siguiente. Se llama al arrancar, antes de aceptar ninguna conexion.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Stats_Init()
+{
+	if(pthread_key_create(&clave, IRC_Stats_Release) != 0)
+		IRC_Log(LOG_ERR, "Error creating the stats key");
+}
+
+/**
+ * @page IRC_Stats_Add IRC_Stats_Add
+ * @brief Suma a un contador desde el hilo en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-stats.h"
+ *
+ * void IRC_Stats_Add(int contador, long n)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Suma a los contadores propios del hilo, que nadie mas escribe. Si suben los usuarios
+ * registrados actualiza tambien el maximo que dan RPL_LOCALUSERS y RPL_GLOBALUSERS.
+ *
+ * @param[in] contador uno de los STATS_
+ * @param[in] n lo que se suma, negativo para restar
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Stats_Add(int contador, long n)
+{
+	Contadores *contadores;
+	long total, anterior;
+
+	if((contadores = IRC_Stats_Own()) == NULL)
+		return;
+
+	atomic_fetch_add_explicit(&contadores->valor[contador], n, memory_order_relaxed);
+
+	if(contador == STATS_USUARIOS && n > 0){
+		total = IRC_Stats_Get(STATS_USUARIOS);
+		anterior = atomic_load_explicit(&maximo, memory_order_relaxed);
+		while(total > anterior && !atomic_compare_exchange_weak(&maximo, &anterior, total));
+	}
+}
+
+/**
+ * @page IRC_Stats_Get IRC_Stats_Get
+ * @brief Valor de un contador
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-stats.h"
+ *
+ * long IRC_Stats_Get(int contador)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Suma los contadores de todos los hilos sin cerrojos. Lo que cambie mientras se suma puede
+ * contarse o no, pero nunca se recorre la lista de usuarios.
+ *
+ * @param[in] contador uno de los STATS_
+ *
+ * @retval long el valor
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Stats_Get(int contador)
+{
+	Contadores *contadores;
+	long total = 0;
+
+	for(contadores = atomic_load(&lista); contadores != NULL; contadores = contadores->sig)
+		total += atomic_load_explicit(&contadores->valor[contador], memory_order_relaxed);
+
+	return (total > 0) ? total : 0;
+}
+
+/**
+ * @page IRC_Stats_Lusers IRC_Stats_Lusers
+ * @brief Añade las respuestas de LUSERS al cliente en curso
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-stats.h"
+ *
+ * void IRC_Stats_Lusers()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Responde RPL_LUSERCLIENT, RPL_LUSEROP, RPL_LUSERUNKNOWN, RPL_LUSERCHANNELS, RPL_LUSERME,
+ * RPL_LOCALUSERS y RPL_GLOBALUSERS con los contadores. Operadores, conexiones sin registrar y
+ * canales solo salen si no son cero. Hay un solo servidor, asi que los numeros locales y globales
+ * coinciden. Lo usan el comando LUSERS y la bienvenida.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Stats_Lusers()
+{
+	long usuarios = IRC_Stats_Get(STATS_USUARIOS), invisibles = IRC_Stats_Get(STATS_INVISIBLES);
+	long mas = atomic_load_explicit(&maximo, memory_order_relaxed);
+
+	long n;
+
+	IRC_Reply_LuserClient(usuarios - invisibles, invisibles);
+	/*Estas tres solo se envian si no son cero*/
+	if((n = IRC_Stats_Get(STATS_OPERADORES)) > 0)
+		IRC_Reply_LuserOp(n);
+	if((n = IRC_Stats_Get(STATS_DESCONOCIDAS)) > 0)
+		IRC_Reply_LuserUnknown(n);
+	if((n = IRC_Stats_Get(STATS_CANALES)) > 0)
+		IRC_Reply_LuserChannels(n);
+	IRC_Reply_LuserMe(usuarios);
+	IRC_Reply_LocalUsers(usuarios, mas);
+	IRC_Reply_GlobalUsers(usuarios, mas);
+}
@@ -0,0 +1,330 @@
+/**
+* @brief Rueda jerarquica de temporizadores para los reactores
+* @file G-2313-07-P1-timer.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-timer.h"
+
+/*! @page irc_timer Rueda de temporizadores
+*
+* <p>Esta sección incluye los temporizadores con los que cada reactor manda PING a los clientes
+* inactivos, desconecta a los que no contestan y a los que no terminan de registrarse.</p>
+*
+* <p>La rueda tiene dos niveles de 64 huecos. En el primero cada hueco es un segundo, en el
+* segundo cada hueco son 64 segundos. Un temporizador que vence en menos de 64 segundos va
+* directamente al hueco de su segundo, el resto al hueco de su bloque de 64 segundos, y cuando
+* la rueda llega a ese bloque se reparten por el primer nivel. Programar, cancelar y vencer un
+* temporizador cuesta lo mismo haya las conexiones que haya.<br>
+* Los temporizadores van dentro de la sesion, asi que la rueda no reserva memoria. Cada reactor
+* tiene su propia rueda y solo la toca su hilo, por eso no lleva cerrojo.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-timer.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Timer_Now</li>
+* <li>@subpage IRC_Timer_Init</li>
+* <li>@subpage IRC_Timer_Add</li>
+* <li>@subpage IRC_Timer_Del</li>
+* <li>@subpage IRC_Timer_Advance</li>
+* <li>@subpage IRC_Timer_Next</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+
+/*Engancha el temporizador al final de la lista*/
+static void IRC_Timer_Link(Timer *lista, Timer *temporizador)
+{
+	temporizador->sig = lista;
+	temporizador->ant = lista->ant;
+	lista->ant->sig = temporizador;
+	lista->ant = temporizador;
+}
+
+/*Deja la lista vacia, apuntando a si misma*/
+static void IRC_Timer_Empty(Timer *lista)
+{
+	lista->sig = lista->ant = lista;
+}
+
+/**
+ * @page IRC_Timer_Now IRC_Timer_Now
+ * @brief Segundo actual de un reloj monotono
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * long IRC_Timer_Now()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Usa CLOCK_MONOTONIC para que un cambio de la hora del sistema no adelante ni retrase los
+ * temporizadores.
+ *
+ * @retval long segundos desde un instante fijo
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Timer_Now()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (long) ts.tv_sec;
+}
+
+/**
+ * @page IRC_Timer_Init IRC_Timer_Init
+ * @brief Deja la rueda vacia
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * void IRC_Timer_Init(Wheel *rueda, long ahora)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Vacia todos los huecos y la lista de vencidos, y fija el segundo desde el que empieza a
+ * avanzar la rueda.
+ *
+ * @param[in] rueda rueda que se inicializa
+ * @param[in] ahora segundo actual
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Timer_Init(Wheel *rueda, long ahora)
+{
+	int i, j;
+
+	for(i = 0; i < TIMER_NIVELES; i++){
+		for(j = 0; j < TIMER_HUECOS; j++)
+			IRC_Timer_Empty(&rueda->huecos[i][j]);
+	}
+	IRC_Timer_Empty(&rueda->vencidos);
+	rueda->ahora = ahora;
+}
+
+/**
+ * @page IRC_Timer_Add IRC_Timer_Add
+ * @brief Programa un temporizador
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * void IRC_Timer_Add(Wheel *rueda, Timer *temporizador, long vence)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Engancha el temporizador en el hueco que le corresponde segun lo que falta para que venza.
+ * Si ya ha vencido va directamente a la lista de vencidos. Los plazos mas largos de lo que
+ * abarca el segundo nivel se recortan, al vencer se vuelven a programar con lo que falte.
+ *
+ * @param[in] rueda rueda del reactor
+ * @param[in] temporizador temporizador que se programa
+ * @param[in] vence segundo en el que vence
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Timer_Add(Wheel *rueda, Timer *temporizador, long vence)
+{
+	long falta = vence - rueda->ahora;
+
+	IRC_Timer_Del(temporizador);
+	temporizador->vence = vence;
+
+	if(falta <= 0){
+		IRC_Timer_Link(&rueda->vencidos, temporizador);
+	}else if(falta < TIMER_HUECOS){
+		IRC_Timer_Link(&rueda->huecos[0][vence & (TIMER_HUECOS-1)], temporizador);
+	}else{
+		/*Un bloque menos del total, para no caer en el bloque que se acaba de repartir*/
+		if(falta >= (long) TIMER_HUECOS * (TIMER_HUECOS-1))
+			vence = rueda->ahora + (long) TIMER_HUECOS * (TIMER_HUECOS-1) - 1;
+		temporizador->vence = vence;
+		IRC_Timer_Link(&rueda->huecos[1][(vence >> TIMER_BITS) & (TIMER_HUECOS-1)], temporizador);
+	}
+}
+
+/**
+ * @page IRC_Timer_Del IRC_Timer_Del
+ * @brief Quita un temporizador de la rueda
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * void IRC_Timer_Del(Timer *temporizador)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Lo desengancha de su hueco. Se puede llamar aunque no este en la rueda.
+ *
+ * @param[in] temporizador temporizador que se cancela
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Timer_Del(Timer *temporizador)
+{
+	if(temporizador->ant == NULL)
+		return;
+
+	temporizador->ant->sig = temporizador->sig;
+	temporizador->sig->ant = temporizador->ant;
+	temporizador->sig = temporizador->ant = NULL;
+}
+
+/**
+ * @page IRC_Timer_Advance IRC_Timer_Advance
+ * @brief Avanza la rueda hasta el segundo dado
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * void IRC_Timer_Advance(Wheel *rueda, long ahora)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Avanza segundo a segundo. Al empezar cada bloque de 64 segundos reparte por el primer nivel
+ * los temporizadores del hueco de ese bloque en el segundo nivel, y en cada segundo pasa el
+ * hueco correspondiente entero a la lista de vencidos.
+ *
+ * @param[in] rueda rueda del reactor
+ * @param[in] ahora segundo actual
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Timer_Advance(Wheel *rueda, long ahora)
+{
+	Timer *lista, *temporizador;
+
+	while(rueda->ahora < ahora){
+		rueda->ahora++;
+
+		if((rueda->ahora & (TIMER_HUECOS-1)) == 0){
+			lista = &rueda->huecos[1][(rueda->ahora >> TIMER_BITS) & (TIMER_HUECOS-1)];
+			while((temporizador = lista->sig) != lista)
+				IRC_Timer_Add(rueda, temporizador, temporizador->vence);
+		}
+
+		lista = &rueda->huecos[0][rueda->ahora & (TIMER_HUECOS-1)];
+		if(lista->sig != lista){
+			/*Se pega la lista entera al final de la de vencidos*/
+			lista->sig->ant = rueda->vencidos.ant;
+			lista->ant->sig = &rueda->vencidos;
+			rueda->vencidos.ant->sig = lista->sig;
+			rueda->vencidos.ant = lista->ant;
+			IRC_Timer_Empty(lista);
+		}
+	}
+}
+
+/**
+ * @page IRC_Timer_Next IRC_Timer_Next
+ * @brief Saca el siguiente temporizador vencido
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-timer.h"
+ *
+ * Timer *IRC_Timer_Next(Wheel *rueda)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Devuelve los temporizadores vencidos de uno en uno y ya fuera de la rueda, de modo que
+ * quien lo recibe puede volver a programarlo.
+ *
+ * @param[in] rueda rueda del reactor
+ *
+ * @retval Timer* temporizador vencido
+ * @retval NULL si no queda ninguno
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Timer *IRC_Timer_Next(Wheel *rueda)
+{
+	Timer *temporizador = rueda->vencidos.sig;
+
+	if(temporizador == &rueda->vencidos)
+		return NULL;
+
+	IRC_Timer_Del(temporizador);
+
+	return temporizador;
+}
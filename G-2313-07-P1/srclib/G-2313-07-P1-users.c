@@ -0,0 +1,1016 @@
+/**
+* @brief Indice de usuarios conectados por nick y por descriptor
+* @file G-2313-07-P1-users.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include "../includes/G-2313-07-P1-users.h"
+
+/*! @page irc_users Indice de usuarios
+*
+* <p>Esta sección incluye el indice con el que el servidor encuentra la sesion de un usuario
+* sin pasar por el TAD. Al repartir un mensaje a un canal hay que saber el socket de cada
+* miembro, y pedirlo con IRCTADUser_GetData supone copiar y liberar cinco cadenas por
+* destinatario. Con el indice basta una busqueda en una tabla hash.</p>
+*
+* <p>Los nicks se guardan en una tabla con direccionamiento abierto y sondeo lineal, sin
+* distinguir mayusculas segun el RFC 1459 ({}|^ son las minusculas de []\~). Las sesiones
+* tambien se indexan por descriptor en una tabla directa.<br>
+* El indice lo comparten todos los reactores, por eso lo protege un cerrojo de
+* lectura/escritura: solo se escribe al conectar, desconectar y cambiar de nick, prefijo o
+* ausencia, y mientras alguien tiene el bloqueo de lectura ninguna sesion se libera.</p>
+*
+* <p>Las sesiones registradas estan ademas en cuatro arrays ordenados por nick, user, host y
+* nombre real, sin distinguir mayusculas. WHO con una mascara que empieza por algo fijo busca
+* ese prefijo en cada uno y recorre solo las sesiones que lo tienen, en vez de todas. Los arrays
+* solo cambian al registrarse, al desconectarse y al cambiar de nick. Las sesiones con el mismo
+* user, host o nombre real van ordenadas por nick, que es unico, asi que el par campo y nick
+* dice el sitio exacto de cada sesion y WHO puede seguir por partes desde el ultimo usuario que
+* reviso aunque los arrays hayan cambiado entre medias.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-users.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Users_Hash</li>
+* <li>@subpage IRC_Users_Equal</li>
+* <li>@subpage IRC_Users_Fold</li>
+* <li>@subpage IRC_Users_Compare</li>
+* <li>@subpage IRC_Users_Connect</li>
+* <li>@subpage IRC_Users_Remove</li>
+* <li>@subpage IRC_Users_SetNick</li>
+* <li>@subpage IRC_Users_SetPrefix</li>
+* <li>@subpage IRC_Users_SetAway</li>
+* <li>@subpage IRC_Users_ReadLock</li>
+* <li>@subpage IRC_Users_Unlock</li>
+* <li>@subpage IRC_Users_Exists</li>
+* <li>@subpage IRC_Users_Find</li>
+* <li>@subpage IRC_Users_Desc</li>
+* <li>@subpage IRC_Users_Field</li>
+* <li>@subpage IRC_Users_Range</li>
+* <li>@subpage IRC_Users_At</li>
+* <li>@subpage IRC_Users_After</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static pthread_rwlock_t cerrojo = PTHREAD_RWLOCK_INITIALIZER; /*!<Protege los dos indices*/
+static Ranura *tabla = NULL;              /*!<Tabla de nicks*/
+static size_t capacidad = 0;              /*!<Huecos de la tabla, potencia de 2*/
+static size_t ocupados = 0;               /*!<Huecos usados, contando los borrados*/
+static Session *por_desc[MAX_DESCRIPTORS]; /*!<Sesion de cada descriptor*/
+static Session borrado;                   /*!<Marca de hueco borrado para no cortar el sondeo*/
+static Session **indices[USERS_INDICES];  /*!<Sesiones registradas ordenadas por cada campo*/
+static int registradas = 0;               /*!<Sesiones en cada indice*/
+static int reservadas = 0;                /*!<Huecos reservados en cada indice*/
+
+
+/*Hueco donde esta el nick, o NULL. Hay que tener el cerrojo*/
+static Ranura *IRC_Users_Slot(const char *nick, unsigned long hash)
+{
+	size_t i;
+
+	if(tabla == NULL)
+		return NULL;
+
+	for(i = hash & (capacidad-1); tabla[i].sesion != NULL; i = (i+1) & (capacidad-1)){
+		if(tabla[i].sesion != &borrado && tabla[i].hash == hash && IRC_Users_Equal(tabla[i].sesion->nick, nick) == TRUE)
+			return &tabla[i];
+	}
+
+	return NULL;
+}
+
+/*Mete la sesion en la tabla, que tiene sitio. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Insert(Session *sesion, unsigned long hash)
+{
+	size_t i;
+
+	for(i = hash & (capacidad-1); tabla[i].sesion != NULL && tabla[i].sesion != &borrado; i = (i+1) & (capacidad-1));
+
+	if(tabla[i].sesion == NULL)
+		ocupados++;
+	tabla[i].hash = hash;
+	tabla[i].sesion = sesion;
+}
+
+/*Dobla la tabla si pasa del 70% de ocupacion, tirando los borrados. Hay que tener el cerrojo de escritura*/
+static long IRC_Users_Grow()
+{
+	Ranura *vieja = tabla;
+	size_t i, antigua = capacidad;
+
+	if(tabla != NULL && (ocupados+1)*10 <= capacidad*7)
+		return TRUE;
+
+	capacidad = (tabla == NULL) ? USERS_INICIAL : capacidad*2;
+	tabla = (Ranura *) calloc(capacidad, sizeof(Ranura));
+	if(tabla == NULL){
+		IRC_Log(LOG_ERR, "Error allocating the nick table");
+		tabla = vieja;
+		capacidad = antigua;
+		return FALSE;
+	}
+
+	ocupados = 0;
+	for(i = 0; i < antigua; i++){
+		if(vieja[i].sesion != NULL && vieja[i].sesion != &borrado)
+			IRC_Users_Insert(vieja[i].sesion, vieja[i].hash);
+	}
+	free(vieja);
+
+	return TRUE;
+}
+
+/*Compone el prefijo de la sesion. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Build(Session *sesion)
+{
+	snprintf(sesion->prefix, sizeof(sesion->prefix), ":%s!%s@%s", sesion->nick, sesion->user, sesion->host);
+}
+
+/*Primera de las cuantas primeras posiciones del indice cuyo campo va despues de clave, o no va antes si igual es TRUE. Hay que tener el cerrojo*/
+static int IRC_Users_Bound(int indice, int cuantas, const char *clave, size_t n, long igual)
+{
+	int inicio = 0, fin = cuantas, medio, orden;
+
+	while(inicio < fin){
+		medio = (inicio + fin) / 2;
+		orden = IRC_Users_Compare(IRC_Users_Field(indices[indice][medio], indice), clave, n);
+		if(orden < 0 || (orden == 0 && igual == FALSE))
+			inicio = medio + 1;
+		else
+			fin = medio;
+	}
+
+	return inicio;
+}
+
+/*Primera de las cuantas primeras posiciones del indice que va despues del campo clave y el nick dado. Hay que tener el cerrojo*/
+static int IRC_Users_Next(int indice, int cuantas, const char *clave, const char *nick)
+{
+	int inicio = 0, fin = cuantas, medio, orden;
+	Session *sesion;
+
+	while(inicio < fin){
+		medio = (inicio + fin) / 2;
+		sesion = indices[indice][medio];
+		orden = IRC_Users_Compare(IRC_Users_Field(sesion, indice), clave, MAX_HOST);
+		if(orden == 0)
+			orden = IRC_Users_Compare(sesion->nick, nick, MAX_NICKNAME+1);
+		if(orden <= 0)
+			inicio = medio + 1;
+		else
+			fin = medio;
+	}
+
+	return inicio;
+}
+
+/*Mete la sesion en su sitio de un indice con cuantas sesiones y hueco para una mas. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Place(int indice, int cuantas, Session *sesion)
+{
+	int n = IRC_Users_Next(indice, cuantas, IRC_Users_Field(sesion, indice), sesion->nick);
+
+	memmove(&indices[indice][n+1], &indices[indice][n], (cuantas - n) * sizeof(Session *));
+	indices[indice][n] = sesion;
+}
+
+/*Saca la sesion de un indice con cuantas sesiones, TRUE si estaba. Hay que tener el cerrojo de escritura*/
+static long IRC_Users_Drop(int indice, int cuantas, Session *sesion)
+{
+	int n;
+
+	for(n = IRC_Users_Bound(indice, cuantas, IRC_Users_Field(sesion, indice), MAX_HOST, TRUE); n < cuantas; n++){
+		if(indices[indice][n] == sesion){
+			memmove(&indices[indice][n], &indices[indice][n+1], (cuantas - n - 1) * sizeof(Session *));
+			return TRUE;
+		}
+		if(IRC_Users_Compare(IRC_Users_Field(indices[indice][n], indice), IRC_Users_Field(sesion, indice), MAX_HOST) != 0)
+			break;
+	}
+
+	return FALSE;
+}
+
+/*Mete una sesion recien registrada en todos los indices. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Index(Session *sesion)
+{
+	Session **ampliado;
+	int i, n;
+
+	if(registradas == reservadas){
+		n = (reservadas == 0) ? USERS_INICIAL : reservadas*2;
+		for(i = 0; i < USERS_INDICES; i++){
+			if((ampliado = (Session **) realloc(indices[i], n * sizeof(Session *))) == NULL){
+				IRC_Log(LOG_ERR, "Error growing the user indexes, %s will not show in WHO", sesion->nick);
+				return;
+			}
+			indices[i] = ampliado;
+		}
+		reservadas = n;
+	}
+
+	for(i = 0; i < USERS_INDICES; i++)
+		IRC_Users_Place(i, registradas, sesion);
+	registradas++;
+}
+
+/*Saca una sesion de todos los indices si esta. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Unindex(Session *sesion)
+{
+	int i;
+
+	if(IRC_Users_Drop(USERS_NICK, registradas, sesion) == FALSE)
+		return;
+
+	for(i = USERS_NICK+1; i < USERS_INDICES; i++)
+		IRC_Users_Drop(i, registradas, sesion);
+	registradas--;
+}
+
+/*Quita la sesion de la tabla de nicks. Hay que tener el cerrojo de escritura*/
+static void IRC_Users_Unlink(Session *sesion)
+{
+	Ranura *ranura;
+
+	if(sesion->nick[0] == '\0')
+		return;
+
+	ranura = IRC_Users_Slot(sesion->nick, IRC_Users_Hash(sesion->nick));
+	if(ranura != NULL && ranura->sesion == sesion)
+		ranura->sesion = &borrado;
+}
+
+/**
+ * @page IRC_Users_Hash IRC_Users_Hash
+ * @brief Calcula el hash de un nombre sin distinguir mayusculas
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * unsigned long IRC_Users_Hash(const char *nombre)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Calcula el hash FNV-1a del nombre pasando cada caracter a minusculas segun el RFC 1459,
+ * de modo que "Nick" y "nICK" caen en el mismo hueco.
+ *
+ * @param[in] nombre nick o nombre de canal
+ *
+ * @retval unsigned long hash del nombre
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+unsigned long IRC_Users_Hash(const char *nombre)
+{
+	unsigned long hash = 2166136261UL;
+
+	for(; *nombre != '\0'; nombre++){
+		hash ^= (unsigned char) IRC_Users_Fold(*nombre);
+		hash *= 16777619UL;
+	}
+
+	return hash;
+}
+
+/**
+ * @page IRC_Users_Equal IRC_Users_Equal
+ * @brief Compara dos nombres sin distinguir mayusculas
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * long IRC_Users_Equal(const char *a, const char *b)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Compara los dos nombres caracter a caracter despues de pasarlos a minusculas segun el
+ * RFC 1459.
+ *
+ * @param[in] a primer nombre
+ * @param[in] b segundo nombre
+ *
+ * @retval TRUE si son el mismo nombre
+ * @retval FALSE si son distintos
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Users_Equal(const char *a, const char *b)
+{
+	for(; *a != '\0' && IRC_Users_Fold(*a) == IRC_Users_Fold(*b); a++, b++);
+
+	return (IRC_Users_Fold(*a) == IRC_Users_Fold(*b)) ? TRUE : FALSE;
+}
+
+/**
+ * @page IRC_Users_Fold IRC_Users_Fold
+ * @brief Pasa un caracter a minusculas segun el RFC 1459
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * char IRC_Users_Fold(char c)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Ademas de las letras pasa []\^ a {}|~, que el RFC 1459 considera sus minusculas. Es la
+ * forma de no distinguir mayusculas de todo el servidor: la usan la tabla de nicks, los indices
+ * ordenados, el indice de nombres de canales y las mascaras, asi todos coinciden en que nombres
+ * son iguales y en que orden van.
+ *
+ * @param[in] c caracter
+ *
+ * @retval char el caracter en minusculas
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+char IRC_Users_Fold(char c)
+{
+	if(c >= 'A' && c <= '^')
+		return c + ('a' - 'A');
+	return c;
+}
+
+/**
+ * @page IRC_Users_Compare IRC_Users_Compare
+ * @brief Compara como strncmp sin distinguir mayusculas segun el RFC 1459
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * int IRC_Users_Compare(const char *a, const char *b, size_t n)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Compara como mucho n caracteres pasados a minusculas con IRC_Users_Fold. Es el orden de los
+ * indices de usuarios y del indice de nombres de canales, asi que sirve para buscar en ellos.
+ *
+ * @param[in] a primer nombre
+ * @param[in] b segundo nombre
+ * @param[in] n caracteres que se comparan como mucho
+ *
+ * @retval int menor, igual o mayor que cero segun a vaya antes, sea igual o vaya despues que b
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+int IRC_Users_Compare(const char *a, const char *b, size_t n)
+{
+	for(; n > 0; a++, b++, n--){
+		if(IRC_Users_Fold(*a) != IRC_Users_Fold(*b))
+			return (unsigned char) IRC_Users_Fold(*a) - (unsigned char) IRC_Users_Fold(*b);
+		if(*a == '\0')
+			break;
+	}
+
+	return 0;
+}
+
+/**
+ * @page IRC_Users_Connect IRC_Users_Connect
+ * @brief Da de alta una sesion en el indice por descriptor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_Connect(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Guarda la sesion en la tabla por descriptor al aceptar la conexion. En la tabla de nicks
+ * no entra hasta que el cliente hace NICK.
+ *
+ * @param[in] sesion sesion de la conexion recien aceptada
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_Connect(Session *sesion)
+{
+	if(sesion->desc < 0 || sesion->desc >= MAX_DESCRIPTORS)
+		return;
+
+	pthread_rwlock_wrlock(&cerrojo);
+	por_desc[sesion->desc] = sesion;
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Users_Remove IRC_Users_Remove
+ * @brief Quita una sesion de los indices
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_Remove(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Quita la sesion de la tabla de nicks, de la de descriptores y de los indices ordenados si se
+ * llego a registrar. Al volver ningun otro hilo
+ * puede estar usandola a traves del indice, asi que ya se puede liberar.
+ *
+ * @param[in] sesion sesion que se va a liberar
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_Remove(Session *sesion)
+{
+	pthread_rwlock_wrlock(&cerrojo);
+
+	IRC_Users_Unlink(sesion);
+	if(sesion->prefix[0] != '\0')
+		IRC_Users_Unindex(sesion);
+	if(sesion->desc >= 0 && sesion->desc < MAX_DESCRIPTORS && por_desc[sesion->desc] == sesion)
+		por_desc[sesion->desc] = NULL;
+
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Users_SetNick IRC_Users_SetNick
+ * @brief Asigna o cambia el nick de una sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * long IRC_Users_SetNick(Session *sesion, const char *nick)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Comprueba y reserva el nick en una sola operacion, de modo que dos clientes no pueden
+ * quedarse con el mismo aunque lo pidan a la vez desde reactores distintos. Si la sesion ya
+ * tenia nick se quita el antiguo de la tabla, y si ya estaba registrada se rehace su prefijo y
+ * se mueve a su nuevo sitio en el indice ordenado por nick.
+ *
+ * @param[in] sesion sesion que cambia de nick
+ * @param[in] nick nick nuevo, de como mucho MAX_NICKNAME caracteres
+ *
+ * @retval TRUE si se ha asignado
+ * @retval FALSE si otra sesion ya lo tiene, es demasiado largo o no hay memoria
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Users_SetNick(Session *sesion, const char *nick)
+{
+	Ranura *ranura;
+	unsigned long hash = IRC_Users_Hash(nick);
+	long indexada = FALSE;
+	int i;
+
+	if(strlen(nick) > MAX_NICKNAME)
+		return FALSE;
+
+	pthread_rwlock_wrlock(&cerrojo);
+
+	ranura = IRC_Users_Slot(nick, hash);
+	if((ranura != NULL && ranura->sesion != sesion) || IRC_Users_Grow() == FALSE){
+		pthread_rwlock_unlock(&cerrojo);
+		return FALSE;
+	}
+
+	IRC_Users_Unlink(sesion);
+	/*El nick ordena todos los indices, asi que se saca y se vuelve a meter en todos*/
+	if(sesion->prefix[0] != '\0' && (indexada = IRC_Users_Drop(USERS_NICK, registradas, sesion)) == TRUE){
+		for(i = USERS_NICK+1; i < USERS_INDICES; i++)
+			IRC_Users_Drop(i, registradas, sesion);
+	}
+	strcpy(sesion->nick, nick);
+	IRC_Users_Insert(sesion, hash);
+	if(sesion->prefix[0] != '\0')
+		IRC_Users_Build(sesion);
+	for(i = 0; i < USERS_INDICES && indexada == TRUE; i++)
+		IRC_Users_Place(i, registradas-1, sesion);
+
+	pthread_rwlock_unlock(&cerrojo);
+
+	return TRUE;
+}
+
+/**
+ * @page IRC_Users_SetPrefix IRC_Users_SetPrefix
+ * @brief Calcula el prefijo de una sesion que termina de registrarse
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_SetPrefix(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Compone ":nick!user@host" una sola vez en la propia sesion, con el cerrojo de escritura
+ * para que otro hilo que lo este leyendo a traves del indice no vea una cadena a medias. A
+ * partir de ahi IRC_Users_SetNick lo rehace en cada cambio de nick. La primera vez mete
+ * ademas la sesion en los indices ordenados que usa WHO.
+ *
+ * @param[in] sesion sesion del usuario, con nick, user y host ya puestos
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_SetPrefix(Session *sesion)
+{
+	long nueva;
+
+	pthread_rwlock_wrlock(&cerrojo);
+	nueva = (sesion->prefix[0] == '\0') ? TRUE : FALSE;
+	IRC_Users_Build(sesion);
+	if(nueva == TRUE)
+		IRC_Users_Index(sesion);
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Users_SetAway IRC_Users_SetAway
+ * @brief Cambia el mensaje de ausencia de una sesion
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_SetAway(Session *sesion, const char *away)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Guarda una copia del mensaje de ausencia, o lo borra si away es NULL. Es lo que consultan
+ * PRIVMSG y WHOIS para saber si el destinatario esta ausente.
+ *
+ * @param[in] sesion sesion del usuario
+ * @param[in] away mensaje de ausencia, NULL si vuelve
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_SetAway(Session *sesion, const char *away)
+{
+	char *copia = NULL, *viejo;
+
+	if(away != NULL){
+		copia = (char *) malloc(strlen(away)+1);
+		if(copia == NULL)
+			return;
+		strcpy(copia, away);
+	}
+
+	pthread_rwlock_wrlock(&cerrojo);
+	viejo = sesion->away;
+	sesion->away = copia;
+	pthread_rwlock_unlock(&cerrojo);
+
+	free(viejo);
+}
+
+/**
+ * @page IRC_Users_ReadLock IRC_Users_ReadLock
+ * @brief Bloquea el indice para leer
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_ReadLock()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Toma el cerrojo de lectura. Se toma una vez antes de recorrer los miembros de un canal y
+ * se suelta al terminar, de modo que las sesiones que devuelve IRC_Users_Find siguen vivas
+ * mientras se les encola el mensaje.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_ReadLock()
+{
+	pthread_rwlock_rdlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Users_Unlock IRC_Users_Unlock
+ * @brief Suelta el bloqueo del indice
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_Unlock()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Suelta el cerrojo tomado con IRC_Users_ReadLock.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_Unlock()
+{
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Users_Exists IRC_Users_Exists
+ * @brief Comprueba si algun usuario tiene un nick
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * long IRC_Users_Exists(const char *nick)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Busca el nick en la tabla tomando y soltando el cerrojo de lectura. Sustituye a pedir
+ * todos los datos del usuario al TAD solo para saber si existe.
+ *
+ * @param[in] nick nick buscado, sin distinguir mayusculas
+ *
+ * @retval TRUE si alguna sesion lo tiene
+ * @retval FALSE si esta libre
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Users_Exists(const char *nick)
+{
+	Session *sesion;
+
+	pthread_rwlock_rdlock(&cerrojo);
+	sesion = IRC_Users_Find(nick);
+	pthread_rwlock_unlock(&cerrojo);
+
+	return (sesion != NULL) ? TRUE : FALSE;
+}
+
+/**
+ * @page IRC_Users_Find IRC_Users_Find
+ * @brief Busca la sesion que tiene un nick
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * Session *IRC_Users_Find(const char *nick)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Busca el nick en la tabla sin reservar memoria. De la sesion devuelta se puede leer
+ * directamente el descriptor, el prefijo y el mensaje de ausencia.
+ *
+ * @param[in] nick nick buscado, sin distinguir mayusculas
+ *
+ * @retval Session* la sesion que tiene el nick
+ * @retval NULL si nadie lo tiene
+ *
+ * @warning Hay que llamarla con el cerrojo de IRC_Users_ReadLock, y la sesion solo se puede
+ * usar hasta soltarlo.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Session *IRC_Users_Find(const char *nick)
+{
+	Ranura *ranura;
+
+	if(nick == NULL)
+		return NULL;
+
+	ranura = IRC_Users_Slot(nick, IRC_Users_Hash(nick));
+
+	return (ranura != NULL) ? ranura->sesion : NULL;
+}
+
+/**
+ * @page IRC_Users_Desc IRC_Users_Desc
+ * @brief Busca la sesion de un descriptor
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * Session *IRC_Users_Desc(int desc)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Devuelve la sesion guardada para el descriptor con un acceso directo a la tabla.
+ *
+ * @param[in] desc descriptor de la conexion
+ *
+ * @retval Session* la sesion de ese descriptor
+ * @retval NULL si no hay ninguna
+ *
+ * @warning Solo la puede usar el hilo que atiende esa conexion o quien tenga el cerrojo de
+ * lectura.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Session *IRC_Users_Desc(int desc)
+{
+	if(desc < 0 || desc >= MAX_DESCRIPTORS)
+		return NULL;
+
+	return por_desc[desc];
+}
+
+/**
+ * @page IRC_Users_Field IRC_Users_Field
+ * @brief Campo de una sesion por el que se ordena un indice
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * const char *IRC_Users_Field(Session *sesion, int indice)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Devuelve el nick, el user, el host o el nombre real de la sesion segun el indice. WHO lo usa
+ * para comparar la mascara con los cuatro campos en el mismo orden que los indices.
+ *
+ * @param[in] sesion sesion
+ * @param[in] indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+ *
+ * @retval const char* el campo, dentro de la propia sesion
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+const char *IRC_Users_Field(Session *sesion, int indice)
+{
+	switch(indice){
+		case USERS_USER:
+			return sesion->user;
+		case USERS_HOST:
+			return sesion->host;
+		case USERS_REAL:
+			return sesion->realname;
+		default:
+			return sesion->nick;
+	}
+}
+
+/**
+ * @page IRC_Users_Range IRC_Users_Range
+ * @brief Posiciones de un indice cuyo campo empieza por un prefijo
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * void IRC_Users_Range(int indice, const char *prefijo, size_t n, int *inicio, int *fin)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Busca con dos busquedas binarias el tramo del indice cuyas sesiones tienen el campo empezando
+ * por los n primeros caracteres del prefijo, sin distinguir mayusculas segun el RFC 1459. Con n
+ * igual a 0 el tramo es todo el indice. Las posiciones solo valen mientras se tiene el bloqueo.
+ *
+ * @param[in] indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+ * @param[in] prefijo prefijo buscado
+ * @param[in] n caracteres del prefijo
+ * @param[out] inicio primera posicion con el prefijo
+ * @param[out] fin posicion siguiente a la ultima con el prefijo
+ *
+ * @warning Hay que llamarla con el cerrojo de IRC_Users_ReadLock.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Users_Range(int indice, const char *prefijo, size_t n, int *inicio, int *fin)
+{
+	*inicio = IRC_Users_Bound(indice, registradas, prefijo, n, TRUE);
+	*fin = IRC_Users_Bound(indice, registradas, prefijo, n, FALSE);
+}
+
+/**
+ * @page IRC_Users_At IRC_Users_At
+ * @brief Sesion que ocupa una posicion de un indice
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * Session *IRC_Users_At(int indice, int posicion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Devuelve la sesion de una posicion del tramo que ha dado IRC_Users_Range.
+ *
+ * @param[in] indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+ * @param[in] posicion posicion en el indice
+ *
+ * @retval Session* la sesion de esa posicion
+ *
+ * @warning Hay que llamarla con el cerrojo de IRC_Users_ReadLock.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+Session *IRC_Users_At(int indice, int posicion)
+{
+	return indices[indice][posicion];
+}
+
+/**
+ * @page IRC_Users_After IRC_Users_After
+ * @brief Primera posicion de un indice que va despues de un usuario
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-users.h"
+ *
+ * int IRC_Users_After(int indice, const char *clave, const char *nick)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Busca en el indice la primera sesion cuyo campo va despues de clave, o que tiene el mismo campo
+ * y un nick que va despues. Como el par campo y nick no se repite, es la sesion que seguia a la
+ * que tenia esos datos aunque esta ya no este o el indice haya cambiado.
+ *
+ * @param[in] indice USERS_NICK, USERS_USER, USERS_HOST o USERS_REAL
+ * @param[in] clave campo del ultimo usuario revisado
+ * @param[in] nick nick del ultimo usuario revisado
+ *
+ * @retval int la posicion, que puede ser el final del indice
+ *
+ * @warning Hay que llamarla con el cerrojo de IRC_Users_ReadLock.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+int IRC_Users_After(int indice, const char *clave, const char *nick)
+{
+	return IRC_Users_Next(indice, registradas, clave, nick);
+}
@@ -12,8 +12,9 @@
 /*! @page auxiliar_functions Utilidades Servidor
 *
 * <p>Esta sección incluye las funciones auxiliares utilizadas por el servidor. estas
-* potencian su funcionamineto y lo optimizan como las funciones que comprueban si existe un
-* usuario o un descriptor.<br>Otras como daemonizar pueden ser usadas por cualquier programa, no es necesario
+* potencian su funcionamineto. Las comprobaciones de si existe un usuario o un descriptor estan ahora
+* en el indice de usuarios (@ref irc_users) y la deteccion de clientes caidos en la rueda de
+* temporizadores (@ref irc_timer).<br>Otras como daemonizar pueden ser usadas por cualquier programa, no es necesario
 * que sea usada por el servidor.<br>
 * Por esto en este módulo se incluyen funciones de gran utlidad para cualquier programa
 * que haga uso de sockets y el TAD de usuarios incluido en la libreria de <b>irc-redes2</b> de la asignatura.</p>
@@ -30,9 +31,6 @@
 * <p>Se incluyen las siguientes funciones de apoyo al servidor, para hacer este mas eficiente:
 * <ul>
 * <li>@subpage daemonizar</li>
-* <li>@subpage isClosed</li>
-* <li>@subpage exist_User</li>
-* <li>@subpage exist_descriptor</li>
 * </ul></p>
 *
 * <hr>
@@ -110,161 +108,3 @@ void daemonizar()
 	close(STDIN_FILENO); close(STDOUT_FILENO); close(STDERR_FILENO); /*Close out thestandard file descriptors*/
 	return;
 }
-
-
-/**
- * @page isClosed isClosed
- * @brief Comprueba si un cliente se ha ido del servidor sin hacer quit
- * <h2>Synopsis</h2>
- *
- * @code
- * #include "includes/G-2313-07-P1-server.h"
- *
- * long isClosed(int desc)
- * @endcode
- *
- *
- * @param[in] desc Descriptor sobre el que se quiere comprobar si la conxion ya no esta abierta.
- *
- * @retval TRUE en caso de que el usuario se haya marchado sin hacer QUIT
- * @retval FALSE en caso de que el usuario siga en el servidor
- *
- * <h2>Descripción</h2>
- *
- * Esta funcion se encarga de comprobar si el socket sigue abierto, es decir, si el usuario se ha marchado pero no
- * ha cerrado la conexion.
- *
- * <hr>
- *
- * <h2>Información</h2>
- * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
- * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
- * @copyright Pareja 7 - Grupo 2313
- *
- * <hr>
- *
- */
-long isClosed(int desc)
-{
-	int actividad;
-	fd_set readfds;
-	struct timeval timeout;
-
-	FD_ZERO(&readfds);
-	FD_SET(desc, &readfds);
-
-	timeout.tv_sec = 0;
-	timeout.tv_usec = 10000;
-
-	actividad = select(desc, &readfds, NULL, NULL, &timeout);
-	if((actividad < 0) && (errno != EINTR)){
-		return TRUE;
-	}else{
-		return FALSE;
-	}
-}
-
-
-/**
- * @page exist_User exist_User
- * @brief Comprueba si existe un usuario con el nick dado.
- * <h2>Synopsis</h2>
- *
- * @code
- * #include "includes/G-2313-07-P1-server.h"
- *
- * long exist_User(char *nick)
- * @endcode
- *
- * @param[in] nick Puntero a char donde se ecuentra el nick que se quiere comprobar
- *
- * @retval TRUE en caso de encontrar un usuario con el nick asociado
- * @retval FALSE en caso de no encontrar un usuario con el nick dado
- *
- * <h2>Descripción</h2>
- *
- * Dado un nick comprueba si hay algun usuario que tenga asociado este nick.
- *
- * <hr>
- *
- * <h2>Información</h2>
- * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
- * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
- * @copyright Pareja 7 - Grupo 2313
- *
- * <hr>
- *
- */
-long exist_User(char *nick)
-{
-	char *unknown_user = NULL, *unknown_real = NULL;
-	long unknown_id = 0;
-	char *host, *IP, *away;
-	int sock = 0;
-	long creationTS, actionTS;
-
-	/* Obtiene todos los parámetros a partir del nick*/
-	if(IRCTADUser_GetData (&unknown_id, &unknown_user, &nick, &unknown_real, &host, &IP, &sock, &creationTS, &actionTS, &away) == IRC_OK){
-		/*Encontrado un usario con el nick dado*/
-		free(unknown_user);
-		free(unknown_real);
-		free(host);
-		free(IP);
-		free(away);
-		return TRUE;
-	}
-	return FALSE;
-}
-
-
-/**
- * @page exist_descriptor exist_descriptor
- * @brief Comprueba si existe un descriptor de usuario
- * <h2>Synopsis</h2>
- *
- * @code
- * #include "includes/G-2313-07-P1-server.h"
- *
- * long exist_descriptor(int* desc)
- * @endcode
- *
- *
- * @param[in] desc Puntero a entero del descriptor que se quiere comporbar si pertenece a algun usuario
- * registrado en el servidor.
- *
- * @retval TRUE en caso de encontrar un usuario con el descriptor asociado
- * @retval FALSE en caso de no encontrar un usuario con el descriptor dado
- *
- * <h2>Descripción</h2>
- *
- * Dado un descriptor busca si en el servidor hay algun usuario que tenga asociado este descriptor.
- *
- * <hr>
- *
- * <h2>Información</h2>
- * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
- * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
- * @copyright Pareja 7 - Grupo 2313
- *
- * <hr>
- *
- */
-long exist_descriptor(int* desc)
-{
-	char *unknown_user = NULL, *unknown_real = NULL, *unknown_nick = NULL;
-	long unknown_id = 0;
-	char *host, *IP, *away;
-	long creationTS, actionTS;
-
-	/* Obtiene todos los parámetros a partir del socket*/
-	if(IRCTADUser_GetData (&unknown_id, &unknown_user, &unknown_nick, &unknown_real, &host, &IP, desc, &creationTS, &actionTS, &away) == IRC_OK){
-		free(unknown_user);
-		free(unknown_nick);
-		free(unknown_real);
-		free(host);
-		free(IP);
-		free(away);
-		return TRUE;
-	}
-	return FALSE;
-}
@@ -0,0 +1,465 @@
+/**
+* @brief Bienvenida y MOTD ya preparados
+* @file G-2313-07-P1-welcome.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include <stdarg.h>     /*Argumentos variables*/
+#include <stdatomic.h>
+#include <time.h>
+#include "../includes/G-2313-07-P1-welcome.h"
+#include "../includes/G-2313-07-P1-reply.h"
+#include "../includes/G-2313-07-P1-stats.h"
+
+/*! @page irc_welcome Bienvenida y MOTD
+*
+* <p>Esta sección incluye la bienvenida que recibe cada cliente al registrarse, de RPL_WELCOME a
+* RPL_ISUPPORT seguida del MOTD, y el propio MOTD.</p>
+*
+* <p>Las respuestas se formatean una vez al arrancar, con el MOTD leido de su fichero, en
+* plantillas con los CR/LF ya puestos. Lo unico que cambia de un cliente a otro es su nick, o su
+* prefijo en RPL_WELCOME, y la plantilla guarda la posicion de cada uno de esos huecos. Dar la
+* bienvenida es copiar los trozos de la plantilla y los datos del cliente en la respuesta, sin
+* formatear nada, asi que una avalancha de reconexiones es casi toda memcpy.<br>
+* Con REHASH o con SIGHUP se preparan plantillas nuevas fuera del cerrojo y se cambian por las
+* anteriores de golpe, de modo que nadie recibe una bienvenida a medias. La señal solo lo apunta y
+* la recarga la hace el siguiente cliente que necesita las plantillas.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P1-welcome.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Welcome_File</li>
+* <li>@subpage IRC_Welcome_Path</li>
+* <li>@subpage IRC_Welcome_Load</li>
+* <li>@subpage IRC_Welcome_Signal</li>
+* <li>@subpage IRC_Welcome_Send</li>
+* <li>@subpage IRC_Welcome_Motd</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static pthread_rwlock_t cerrojo = PTHREAD_RWLOCK_INITIALIZER; /*!<Protege el cambio de plantillas*/
+static Bienvenida *actual = NULL;        /*!<Plantillas en uso*/
+static char fichero[PATH_MAX] = WELCOME_MOTD; /*!<Fichero del MOTD*/
+static char arranque[64] = "";           /*!<Fecha de arranque para RPL_CREATED*/
+static atomic_int recargar = 0;          /*!<SIGHUP ha pedido recargar las plantillas*/
+
+
+/*Añade texto con formato al final de la plantilla, ampliandola si no cabe*/
+static void IRC_Welcome_Format(Plantilla *plantilla, const char *formato, va_list args)
+{
+	va_list copia;
+	char *datos;
+	size_t libre;
+	int n;
+
+	while(plantilla->error == FALSE){
+		libre = plantilla->capacidad - plantilla->len;
+		va_copy(copia, args);
+		n = vsnprintf(plantilla->datos != NULL ? plantilla->datos + plantilla->len : NULL, libre, formato, copia);
+		va_end(copia);
+
+		if(n < 0){
+			plantilla->error = TRUE;
+		}else if((size_t) n < libre){
+			plantilla->len += n;
+			return;
+		}else if((datos = (char *) realloc(plantilla->datos, plantilla->capacidad*2 + n + 1)) == NULL){
+			plantilla->error = TRUE;
+		}else{
+			plantilla->datos = datos;
+			plantilla->capacidad = plantilla->capacidad*2 + n + 1;
+		}
+	}
+}
+
+/*Añade texto con formato al final de la plantilla*/
+static void IRC_Welcome_Add(Plantilla *plantilla, const char *formato, ...)
+{
+	va_list args;
+
+	va_start(args, formato);
+	IRC_Welcome_Format(plantilla, formato, args);
+	va_end(args);
+}
+
+/*Apunta un hueco para un dato del cliente en la posicion actual*/
+static void IRC_Welcome_Slot(Plantilla *plantilla, int campo)
+{
+	Hueco *huecos;
+	int n;
+
+	if(plantilla->error == TRUE)
+		return;
+
+	if(plantilla->nhuecos == plantilla->reservados){
+		n = (plantilla->reservados == 0) ? 8 : plantilla->reservados*2;
+		if((huecos = (Hueco *) realloc(plantilla->huecos, n * sizeof(Hueco))) == NULL){
+			plantilla->error = TRUE;
+			return;
+		}
+		plantilla->huecos = huecos;
+		plantilla->reservados = n;
+	}
+
+	plantilla->huecos[plantilla->nhuecos].posicion = plantilla->len;
+	plantilla->huecos[plantilla->nhuecos++].campo = campo;
+}
+
+/*Añade una respuesta numerica ":servidor nnn <nick> ..." con el nick como hueco*/
+static void IRC_Welcome_Numeric(Plantilla *plantilla, int numerico, const char *formato, ...)
+{
+	va_list args;
+
+	IRC_Welcome_Add(plantilla, ":%s %03d ", SERVER, numerico);
+	IRC_Welcome_Slot(plantilla, HUECO_NICK);
+	IRC_Welcome_Add(plantilla, " ");
+
+	va_start(args, formato);
+	IRC_Welcome_Format(plantilla, formato, args);
+	va_end(args);
+
+	IRC_Welcome_Add(plantilla, "\r\n");
+}
+
+/*Libera unas plantillas*/
+static void IRC_Welcome_Free(Bienvenida *bienvenida)
+{
+	if(bienvenida == NULL)
+		return;
+
+	free(bienvenida->registro.datos);
+	free(bienvenida->registro.huecos);
+	free(bienvenida->motd.datos);
+	free(bienvenida->motd.huecos);
+	free(bienvenida);
+}
+
+/*Prepara RPL_MOTDSTART, una RPL_MOTD por linea del fichero y RPL_ENDOFMOTD, o ERR_NOMOTD si no se puede leer*/
+static void IRC_Welcome_ReadMotd(Plantilla *plantilla)
+{
+	char linea[MAX_BUFFER];
+	int ancho = MAX_BUFFER - MAX_NICKNAME - (int) strlen(SERVER) - 16;
+	size_t n;
+	FILE *f;
+	int c;
+
+	if((f = fopen(fichero, "r")) == NULL){
+		IRC_Log(LOG_WARNING, "Cannot read MOTD %s", fichero);
+		IRC_Welcome_Numeric(plantilla, 422, ":MOTD File is missing");
+		return;
+	}
+
+	IRC_Welcome_Numeric(plantilla, 375, ":- %s Message of the day - ", SERVER);
+	while(fgets(linea, sizeof(linea), f) != NULL){
+		n = strcspn(linea, "\r\n");
+		/*Lo que sobre de una linea demasiado larga se descarta*/
+		if(linea[n] == '\0' && n == sizeof(linea) - 1){
+			while((c = fgetc(f)) != EOF && c != '\n');
+		}
+		linea[n] = '\0';
+		IRC_Welcome_Numeric(plantilla, 372, ":- %.*s", ancho, linea);
+	}
+	IRC_Welcome_Numeric(plantilla, 376, ":End of MOTD command");
+
+	fclose(f);
+}
+
+/*Añade a la respuesta una plantilla con los datos del cliente en sus huecos. Hay que tener el cerrojo*/
+static void IRC_Welcome_Render(const Plantilla *plantilla, Session *sesion)
+{
+	const char *dato;
+	size_t desde = 0;
+	int i;
+
+	for(i = 0; i < plantilla->nhuecos; i++){
+		IRC_Reply_Bytes(plantilla->datos + desde, plantilla->huecos[i].posicion - desde);
+		dato = (plantilla->huecos[i].campo == HUECO_PREFIJO) ? sesion->prefix + 1 : sesion->nick;
+		IRC_Reply_Bytes(dato, strlen(dato));
+		desde = plantilla->huecos[i].posicion;
+	}
+	IRC_Reply_Bytes(plantilla->datos + desde, plantilla->len - desde);
+}
+
+/*Recarga las plantillas si SIGHUP lo ha pedido, solo uno de los hilos que lo vean*/
+static void IRC_Welcome_Pending()
+{
+	if(atomic_load_explicit(&recargar, memory_order_relaxed) != 0 && atomic_exchange(&recargar, 0) != 0)
+		IRC_Welcome_Load();
+}
+
+/**
+ * @page IRC_Welcome_File IRC_Welcome_File
+ * @brief Elige el fichero del MOTD
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * void IRC_Welcome_File(const char *ruta)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es la opcion -m del servidor. Guarda la ruta absoluta, porque al demonizar el directorio de
+ * trabajo pasa a ser la raiz y una ruta relativa ya no serviria al recargar. Si el fichero aun no
+ * existe se guarda tal cual.
+ *
+ * @param[in] ruta fichero del MOTD
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Welcome_File(const char *ruta)
+{
+	if(realpath(ruta, fichero) == NULL){
+		strncpy(fichero, ruta, sizeof(fichero) - 1);
+		fichero[sizeof(fichero) - 1] = '\0';
+	}
+}
+
+/**
+ * @page IRC_Welcome_Path IRC_Welcome_Path
+ * @brief Ruta del fichero del MOTD
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * const char *IRC_Welcome_Path()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * La usa REHASH para decir en RPL_REHASHING que fichero vuelve a leer.
+ *
+ * @retval const char* la ruta
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+const char *IRC_Welcome_Path()
+{
+	return fichero;
+}
+
+/**
+ * @page IRC_Welcome_Load IRC_Welcome_Load
+ * @brief Prepara las plantillas y las cambia por las anteriores
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * long IRC_Welcome_Load()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Formatea RPL_WELCOME, con el prefijo del cliente como hueco, RPL_YOURHOST, RPL_CREATED,
+ * RPL_MYINFO y RPL_ISUPPORT con los limites del servidor, y lee el fichero del MOTD. Todo se
+ * prepara sin el cerrojo; con el de escritura solo se cambia el puntero, y las plantillas
+ * anteriores se liberan despues, cuando ya nadie puede estar copiandolas.
+ *
+ * @retval TRUE si se han preparado
+ * @retval FALSE si no hay memoria, y se siguen usando las anteriores
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+long IRC_Welcome_Load()
+{
+	Bienvenida *nueva, *vieja;
+	time_t ahora;
+
+	if(arranque[0] == '\0'){
+		ahora = time(NULL);
+		strftime(arranque, sizeof(arranque), "%a %b %d %Y at %H:%M:%S", localtime(&ahora));
+	}
+
+	if((nueva = (Bienvenida *) calloc(1, sizeof(Bienvenida))) == NULL){
+		IRC_Log(LOG_ERR, "Error allocating the welcome");
+		return FALSE;
+	}
+
+	IRC_Welcome_Add(&nueva->registro, ":%s 001 ", SERVER);
+	IRC_Welcome_Slot(&nueva->registro, HUECO_NICK);
+	IRC_Welcome_Add(&nueva->registro, " :Welcome to the Internet Relay Network ");
+	IRC_Welcome_Slot(&nueva->registro, HUECO_PREFIJO);
+	IRC_Welcome_Add(&nueva->registro, "\r\n");
+	IRC_Welcome_Numeric(&nueva->registro, 2, ":Your host is %s, running version %s", SERVER, WELCOME_VERSION);
+	IRC_Welcome_Numeric(&nueva->registro, 3, ":This server was created %s", arranque);
+	IRC_Welcome_Numeric(&nueva->registro, 4, "%s %s %s %s", SERVER, WELCOME_VERSION, WELCOME_UMODOS, WELCOME_CMODOS);
+	IRC_Welcome_Numeric(&nueva->registro, 5, "CHANTYPES=# PREFIX=(ov)@+ NICKLEN=%d CHANNELLEN=%d CHANLIMIT=#:%d "
+		"MAXTARGETS=%d TARGMAX=PRIVMSG:%d,NOTICE:%d ELIST=CMNTU :are supported by this server",
+		MAX_NICKNAME, MAX_CHANNELNAME, MAX_CHANELS_USER, MAX_TARGETS, MAX_TARGETS, MAX_TARGETS);
+
+	IRC_Welcome_ReadMotd(&nueva->motd);
+
+	if(nueva->registro.error == TRUE || nueva->motd.error == TRUE){
+		IRC_Log(LOG_ERR, "Error allocating the welcome");
+		IRC_Welcome_Free(nueva);
+		return FALSE;
+	}
+
+	pthread_rwlock_wrlock(&cerrojo);
+	vieja = actual;
+	actual = nueva;
+	pthread_rwlock_unlock(&cerrojo);
+
+	IRC_Welcome_Free(vieja);
+	IRC_Log(LOG_INFO, "Welcome ready with MOTD from %s", fichero);
+
+	return TRUE;
+}
+
+/**
+ * @page IRC_Welcome_Signal IRC_Welcome_Signal
+ * @brief Manejador de SIGHUP
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * void IRC_Welcome_Signal(int senal)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Dentro de un manejador no se puede leer un fichero ni reservar memoria, asi que solo apunta
+ * que hay que recargar. La siguiente bienvenida o el siguiente MOTD llaman a IRC_Welcome_Load.
+ *
+ * @param[in] senal señal recibida
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Welcome_Signal(int senal)
+{
+	atomic_store(&recargar, 1);
+}
+
+/**
+ * @page IRC_Welcome_Send IRC_Welcome_Send
+ * @brief Añade a la respuesta la bienvenida de un cliente que se acaba de registrar
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * void IRC_Welcome_Send(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Copia en la respuesta la plantilla de RPL_WELCOME a RPL_ISUPPORT y la del MOTD con el nick y
+ * el prefijo del cliente en sus huecos, con el cerrojo de lectura para que una recarga no cambie
+ * las plantillas a mitad. Entre las dos van las respuestas de LUSERS, que cambian en cada
+ * bienvenida y se sacan de @ref irc_stats.
+ *
+ * @param[in] sesion cliente, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Welcome_Send(Session *sesion)
+{
+	IRC_Welcome_Pending();
+
+	pthread_rwlock_rdlock(&cerrojo);
+	if(actual != NULL){
+		IRC_Welcome_Render(&actual->registro, sesion);
+		IRC_Stats_Lusers();
+		IRC_Welcome_Render(&actual->motd, sesion);
+	}
+	pthread_rwlock_unlock(&cerrojo);
+}
+
+/**
+ * @page IRC_Welcome_Motd IRC_Welcome_Motd
+ * @brief Añade a la respuesta el MOTD
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P1-welcome.h"
+ *
+ * void IRC_Welcome_Motd(Session *sesion)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Es el comando MOTD: copia la plantilla del MOTD con el nick del cliente en sus huecos.
+ *
+ * @param[in] sesion cliente, con la respuesta abierta con IRC_Reply_Begin
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Welcome_Motd(Session *sesion)
+{
+	IRC_Welcome_Pending();
+
+	pthread_rwlock_rdlock(&cerrojo);
+	if(actual != NULL)
+		IRC_Welcome_Render(&actual->motd, sesion);
+	pthread_rwlock_unlock(&cerrojo);
+}
@@ -21,6 +21,7 @@
 #include <netdb.h>
 
 #include "G-2313-07-P2-ClientFunctions.h"
+#include "G-2313-07-P2-log.h"
 
 #define PORT 6667
 
@@ -0,0 +1,87 @@
+/**
+* @brief Cabeceras del registro asincrono de mensajes del cliente
+* @file G-2313-07-P2-log.h
+*
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdarg.h>     /*Argumentos variables*/
+#include <stdatomic.h>  /*Indices de los anillos*/
+#include <syslog.h>
+#include <pthread.h>
+
+
+#define LOG_ANILLO 256     /*!<Lineas del anillo de cada hilo, potencia de 2*/
+#define LOG_LINEA 256      /*!<Tamaño maximo de cada linea, se recorta lo que sobre*/
+#define LOG_ESPERA 50      /*!<Milisegundos que duerme el hilo de vaciado si no hay nada*/
+
+
+/**
+* @brief Traza de depuracion, desaparece al compilar con NDEBUG (make RELEASE=1)
+*/
+#ifdef NDEBUG
+#define IRC_Debug(...) ((void) 0)
+#else
+#define IRC_Debug(...) IRC_Log(LOG_DEBUG, __VA_ARGS__)
+#endif
+
+
+/**
+* @brief Linea pendiente de enviar a syslog
+*/
+typedef struct _Linea {
+	int nivel;               /*!<Prioridad de syslog*/
+	char texto[LOG_LINEA];   /*!<Mensaje ya formateado*/
+} Linea;
+
+
+/**
+* @brief Anillo de lineas de un hilo, lo escribe solo ese hilo y lo vacia solo el hilo de vaciado
+*/
+typedef struct _Anillo {
+	Linea lineas[LOG_ANILLO];  /*!<Lineas del anillo*/
+	atomic_ulong escritas;     /*!<Lineas escritas desde que se creo*/
+	atomic_ulong leidas;       /*!<Lineas ya enviadas a syslog*/
+	atomic_ulong perdidas;     /*!<Lineas descartadas por encontrar el anillo lleno*/
+	atomic_int libre;          /*!<El hilo que lo usaba ha terminado y otro lo puede coger*/
+	struct _Anillo *sig;       /*!<Siguiente anillo de la lista*/
+} Anillo;
+
+
+/**
+* @brief Lanza el hilo que vacia los anillos en syslog
+*
+* @param nivel prioridad maxima que se registra, por ejemplo LOG_INFO
+*/
+void IRC_Log_Init(int nivel);
+
+
+/**
+* @brief Cambia en caliente la prioridad maxima que se registra
+*
+* @param nivel prioridad de syslog, de LOG_EMERG a LOG_DEBUG
+*/
+void IRC_Log_Level(int nivel);
+
+
+/**
+* @brief Registra un mensaje sin llamar a syslog desde el hilo que lo genera
+*
+* @param nivel prioridad de syslog
+* @param formato formato como el de printf
+*/
+void IRC_Log(int nivel, const char *formato, ...);
+
+
+/**
+* @brief Envia a syslog todo lo pendiente, por ejemplo antes de terminar
+*/
+void IRC_Log_Flush();
+
+#endif
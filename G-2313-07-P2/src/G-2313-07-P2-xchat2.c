@@ -663,14 +663,14 @@ long IRCInterface_Connect(char *nick, char *user, char *realname, char *password
 	/*Creamos el socket para el cliente*/
 	desc = socket(AF_INET, SOCK_STREAM, 0);
 	if (desc < 0) {
-			syslog(LOG_INFO, "CLIENTE: Error creando el socket");
+			IRC_Log(LOG_ERR, "CLIENTE: Error creando el socket");
 			return IRCERR_NOCONNECT;
 	}
 
 	/*Obtenemos la DNS del servidor*/
 	servidor = gethostbyname(server);
 	if (servidor == NULL) {
-			syslog(LOG_INFO, "CLIENTE: No existe el servidor %s\n", server);
+			IRC_Log(LOG_ERR, "CLIENTE: No existe el servidor %s\n", server);
 			return IRCERR_NOCONNECT;
 	}
 
@@ -682,7 +682,7 @@ long IRCInterface_Connect(char *nick, char *user, char *realname, char *password
 
 	/*Conexion con el servidor*/
 	if (connect(desc, (struct sockaddr*) &serveraddr, sizeof (serveraddr)) < 0) {
-			syslog(LOG_INFO, "CLIENTE: Error conectando con el servidor %s", server);
+			IRC_Log(LOG_ERR, "CLIENTE: Error conectando con el servidor %s", server);
 			return IRCERR_NOCONNECT;
 	}
 
@@ -700,10 +700,10 @@ long IRCInterface_Connect(char *nick, char *user, char *realname, char *password
 
 
 	if (send(desc, msg, strlen(msg), 0) < 0) {
-		syslog(LOG_INFO, "CLIENTE: Error al enviar el mensaje de registro al servidor");
+		IRC_Log(LOG_ERR, "CLIENTE: Error al enviar el mensaje de registro al servidor");
 		return IRCERR_NOCONNECT;
 	}
-	syslog(LOG_INFO, "CLIENTE: Mensaje para registro enviado al servidor %s", server);
+	IRC_Log(LOG_INFO, "CLIENTE: Mensaje para registro enviado al servidor %s", server);
 
 	/*Enviamos al registro plano los mensajes que acabamos de enviar*/
 	IRCInterface_PlaneRegisterOutMessage(msg);
@@ -1206,6 +1206,9 @@ boolean IRCInterface_DisconnectServer(char *server, int port)
 	close(desc);
 	free(msg);
 
+	/*Lo que quede en los anillos del registro sale ya, por si se cierra el cliente*/
+	IRC_Log_Flush();
+
 	return TRUE;
 }
 
@@ -1780,11 +1783,23 @@ Main
 
 int main (int argc, char *argv[])
 {
+	int i, nivel = LOG_INFO;
+
+	/*Con -l N se registran los mensajes de prioridad N o mas, 7 (LOG_DEBUG) para las trazas*/
+	for(i = 1; i < argc; i++){
+		if(strcmp(argv[i], "-l") == 0 && i+1 < argc)
+			nivel = atoi(argv[++i]);
+	}
+	IRC_Log_Init(nivel);
+
 	/* La función IRCInterface_Run debe ser llamada al final      */
 	/* del main y es la que activa el interfaz gráfico quedándose */
 	/* en esta función hasta que se pulsa alguna salida del       */
 	/* interfaz gráfico.                                          */
 	IRCInterface_Run(argc, argv);
 
+	/*Antes de salir se vacia el registro para no perder las ultimas lineas*/
+	IRC_Log_Flush();
+
 	return 0;
 }
@@ -98,7 +98,7 @@ void* IRC_Client_Recieve(void* thr_info)
       pthread_exit(NULL);
     }
 
-    syslog(LOG_INFO, "CLIENT: Recibo del servidor %s", mensaje);
+    IRC_Debug("CLIENT: Recibo del servidor %s", mensaje);
 
     /*Dividimos el mensaje y parseamos*/
     str = IRC_UnPipelineCommands(mensaje, &command);
@@ -88,21 +88,21 @@ char* IRC_Client_Parser(char* command, long option)
   switch (option){
 
     case UNAMES:
-      syslog(LOG_INFO, "CLIENT: Case -> UNAMES");
+      IRC_Debug("CLIENT: Case -> UNAMES");
       if(IRCUserParse_Names(command, &channel, &targetserver) == IRC_OK){
         IRCMsg_Names(&msg, NULL, channel, targetserver);
       }
       break;
 
     case ULIST:
-      syslog(LOG_INFO, "CLIENT: Case -> ULIST");
+      IRC_Debug("CLIENT: Case -> ULIST");
       if(IRCUserParse_List(command, &channel, &target) == IRC_OK){
         IRCMsg_List(&msg, NULL, channel, target);
       }
       break;
 
     case UJOIN:
-      syslog(LOG_INFO, "CLIENT: Case -> UJOIN");
+      IRC_Debug("CLIENT: Case -> UJOIN");
       if(IRCUserParse_Join(command, &channel, &password) == IRC_OK){
         IRC_ToLower (channel);
         IRCMsg_Join(&msg, NULL, channel, password, NULL);
@@ -110,7 +110,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UPART:
-      syslog(LOG_INFO, "CLIENT: Case -> UPART");
+      IRC_Debug("CLIENT: Case -> UPART");
       channel = IRCInterface_ActiveChannelName(); /*EL programador no puede liberar este puntero*/
       if(IRCUserParse_Part(command, &mensaje) == IRC_OK){
         if(mensaje != NULL){
@@ -128,7 +128,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UQUIT:
-      syslog(LOG_INFO, "CLIENT: Case -> UQUIT");
+      IRC_Debug("CLIENT: Case -> UQUIT");
       if(IRCUserParse_Quit(command, &channel) == IRC_OK){
         IRCMsg_Quit(&msg, NULL, channel);
         IRCInterface_PlaneRegisterOutMessage(msg);
@@ -139,14 +139,14 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UNICK:
-      syslog(LOG_INFO, "CLIENT: Case -> UNICK");
+      IRC_Debug("CLIENT: Case -> UNICK");
       if(IRCUserParse_Nick(command, &nick_new) == IRC_OK){
         IRCMsg_Nick(&msg, NULL, nick_new, NULL);
       }
       break;
 
     case UAWAY:
-      syslog(LOG_INFO, "CLIENT: Case -> UAWAY");
+      IRC_Debug("CLIENT: Case -> UAWAY");
       if(IRCUserParse_Away(command, &mensaje) == IRC_OK){
         if(mensaje == NULL){
           IRCMsg_Away(&msg, NULL, "No estoy!");
@@ -157,21 +157,21 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UWHOIS:
-      syslog(LOG_INFO, "CLIENT: Case -> UWHOIS");
+      IRC_Debug("CLIENT: Case -> UWHOIS");
       if(IRCUserParse_Whois(command, &mensaje) == IRC_OK){
         IRCMsg_Whois(&msg, NULL, NULL, mensaje);
       }
       break;
 
     case UWHO:
-      syslog(LOG_INFO, "CLIENT: Case -> UWHO");
+      IRC_Debug("CLIENT: Case -> UWHO");
       if(IRCUserParse_Who(command, &mensaje) == IRC_OK){
         IRCMsg_Who(&msg, NULL, mensaje, NULL);
       }
       break;
 
     case UKICK:
-      syslog(LOG_INFO, "CLIENT: Case -> UKICK");
+      IRC_Debug("CLIENT: Case -> UKICK");
       channel = IRCInterface_ActiveChannelName();
       if(IRCUserParse_Kick(command, &nick, &mensaje) == IRC_OK){
         IRCMsg_Kick(&msg, NULL, channel, nick, mensaje);
@@ -179,7 +179,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UTOPIC:
-      syslog(LOG_INFO, "CLIENT: Case -> UTOPIC");
+      IRC_Debug("CLIENT: Case -> UTOPIC");
       channel = IRCInterface_ActiveChannelName();
       if(IRCUserParse_Topic(command, &topic) == IRC_OK){
         IRCMsg_Topic(&msg, NULL, channel, topic);
@@ -187,7 +187,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UMSG:
-      syslog(LOG_INFO, "CLIENT: Case -> UMSG");
+      IRC_Debug("CLIENT: Case -> UMSG");
       if(IRCUserParse_Msg(command, &target, &mensaje) == IRC_OK){
         IRCMsg_Privmsg(&msg, NULL, target, mensaje);
         return msg;
@@ -195,28 +195,28 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     case UNOTICE:
-      syslog(LOG_INFO, "CLIENT: Case -> UNOTICE");
+      IRC_Debug("CLIENT: Case -> UNOTICE");
       if(IRCUserParse_Notice(command, &target, &mensaje) == IRC_OK){
         IRCMsg_Notice(&msg, NULL, target, mensaje);
       }
       break;
 
     case UPING:
-      syslog(LOG_INFO, "CLIENT: Case -> UPING");
+      IRC_Debug("CLIENT: Case -> UPING");
       if(IRCUserParse_Ping(command, &user) == IRC_OK){
         IRCMsg_Ping(&msg, NULL, user, NULL);
       }
       break;
 
     case UMOTD:
-      syslog(LOG_INFO, "CLIENT: Case -> UMOTD");
+      IRC_Debug("CLIENT: Case -> UMOTD");
       if(IRCUserParse_Motd(command, &server) == IRC_OK){
         IRCMsg_Motd(&msg, NULL, server);
       }
       break;
 
     case UMODE:
-      syslog(LOG_INFO, "CLIENT: Case -> UMODE");
+      IRC_Debug("CLIENT: Case -> UMODE");
       channel = IRCInterface_ActiveChannelName();
       if(IRCUserParse_Mode(command, &mode, &filter) == IRC_OK){
         IRCMsg_Mode(&msg, NULL, channel, mode, NULL);
@@ -224,7 +224,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
 
     default: /*Es que escribe por un canal*/
-      syslog(LOG_INFO, "CLIENT: Case -> DEFAULT (mensaje) o comando desconocido");
+      IRC_Debug("CLIENT: Case -> DEFAULT (mensaje) o comando desconocido");
 
       channel = IRCInterface_ActiveChannelName();
       IRCInterface_GetMyUserInfo(&nick, &user, &realname, &password, &server, &port, &ssl);
@@ -244,7 +244,7 @@ char* IRC_Client_Parser(char* command, long option)
       break;
   }
 
-  syslog(LOG_INFO, "Mensaje creado (CLIENT): %s", msg);
+  IRC_Debug("Mensaje creado (CLIENT): %s", msg);
   return msg;
 }
 
@@ -309,7 +309,7 @@ void IRC_Reply_Parser(char* command, int desc)
   switch (IRC_CommandQuery(command)) {
 
     case NICK:
-      syslog(LOG_INFO, "CLIENT: He recibido comando NICK del server");
+      IRC_Debug("CLIENT: He recibido comando NICK del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
 
       if(IRCParse_Nick(command, &prefix, &nick, &msg) == IRC_OK){
@@ -331,7 +331,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case MODE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando MODE del server");
+      IRC_Debug("CLIENT: He recibido comando MODE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Mode (command, &prefix, &channel, &mode, &target) == IRC_OK){
         if(prefix == NULL)
@@ -430,12 +430,12 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case QUIT:
-      syslog(LOG_INFO, "CLIENT: He recibido comando QUIT del server");
+      IRC_Debug("CLIENT: He recibido comando QUIT del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case JOIN:
-      syslog(LOG_INFO, "CLIENT: He recibido comando JOIN del server");
+      IRC_Debug("CLIENT: He recibido comando JOIN del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Join(command, &prefix, &channel, &key, &msg) == IRC_OK){
         if(prefix == NULL)
@@ -466,7 +466,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case PART:
-      syslog(LOG_INFO, "CLIENT: He recibido comando PART del server");
+      IRC_Debug("CLIENT: He recibido comando PART del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if (IRCParse_Part(command, &prefix, &channel, &msg) == IRC_OK) {
         if(prefix == NULL)
@@ -492,7 +492,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case TOPIC:
-      syslog(LOG_INFO, "CLIENT: He recibido comando TOPIC del server");
+      IRC_Debug("CLIENT: He recibido comando TOPIC del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Topic(command, &prefix, &channel, &msg) == IRC_OK){
         if(prefix == NULL)
@@ -509,20 +509,20 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case NAMES:
-      syslog(LOG_INFO, "CLIENT: He recibido comando NAMES del server");
+      IRC_Debug("CLIENT: He recibido comando NAMES del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case LIST:
-      syslog(LOG_INFO, "CLIENT: He recibido comando LIST del server");
+      IRC_Debug("CLIENT: He recibido comando LIST del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case KICK:
-      syslog(LOG_INFO, "CLIENT: He recibido comando KICK del server");
+      IRC_Debug("CLIENT: He recibido comando KICK del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Kick(command, &prefix, &channel, &user, &msg) == IRC_OK){
-        syslog(LOG_INFO, "HE PARSEADO KICK");
+        IRC_Debug("HE PARSEADO KICK");
         if(prefix == NULL)
           break;
 
@@ -544,7 +544,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case PRIVMSG:
-      syslog(LOG_INFO, "CLIENT: He recibido comando PRIVMSG del server");
+      IRC_Debug("CLIENT: He recibido comando PRIVMSG del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Privmsg(command, &prefix, &msgtarget, &msg) == IRC_OK){
         if (msg[0] == 1) {
@@ -576,17 +576,17 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case MOTD:
-      syslog(LOG_INFO, "CLIENT: He recibido comando MOTD del server");
+      IRC_Debug("CLIENT: He recibido comando MOTD del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case WHOIS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando WHOIS del server");
+      IRC_Debug("CLIENT: He recibido comando WHOIS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case WHO:
-      syslog(LOG_INFO, "CLIENT: He recibido comando WHO del server");
+      IRC_Debug("CLIENT: He recibido comando WHO del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if (IRCParse_RplWhoReply(command, &prefix, &nick, &channel, &user, &host, &server, &nick2, &type, &msg, &hopcount, &realname) == IRC_OK) {
           IRCInterface_AddNickChannelThread(channel, nick2, user, realname, host, NONE);
@@ -596,7 +596,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case PING:
-      syslog(LOG_INFO, "CLIENT: He recibido comando PING del server");
+      IRC_Debug("CLIENT: He recibido comando PING del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_Ping(command, &prefix, &server, &host, &msg) == IRC_OK){
 
@@ -611,7 +611,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case PONG:
-      syslog(LOG_INFO, "CLIENT: He recibido comando PONG del server");
+      IRC_Debug("CLIENT: He recibido comando PONG del server");
       ping_flag = 0;
       IRCInterface_PlaneRegisterInMessageThread(command);
 
@@ -631,12 +631,12 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case AWAY:
-      syslog(LOG_INFO, "CLIENT: He recibido comando AWAY del server");
+      IRC_Debug("CLIENT: He recibido comando AWAY del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case PASS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando PASS del server");
+      IRC_Debug("CLIENT: He recibido comando PASS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_Pass (command, &prefix, &password);
       channel = IRCInterface_ActiveChannelName();
@@ -650,13 +650,13 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case SETNAME:
-      syslog(LOG_INFO, "CLIENT: He recibido comando SETNAME del server");
+      IRC_Debug("CLIENT: He recibido comando SETNAME del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
 
       break;
 
     case RPL_WELCOME:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WELCOME del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WELCOME del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplWelcome(command, &prefix, &nick, &msg) == IRC_OK){
         IRCInterface_WriteSystemThread(NULL, msg);
@@ -666,7 +666,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_CREATED:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_CREATED del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_CREATED del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplCreated(command, &prefix, &nick, &timedate, &msg) == IRC_OK){
         IRCInterface_WriteSystemThread(NULL, msg);
@@ -676,7 +676,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_YOURHOST:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_YOURHOST del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_YOURHOST del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplYourHost (command, &prefix, &nick, &msg, &servername, &versionname) == IRC_OK){
         IRCInterface_WriteSystemThread(NULL, msg);
@@ -686,7 +686,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_LUSERCLIENT:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LUSERCLIENT del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LUSERCLIENT del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplLuserClient(command, &prefix, &nick, &msg, &nusers, &ninvisibles, &nservers);
       IRCInterface_WriteSystemThread(NULL, msg);
@@ -696,23 +696,23 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_LUSERME:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LUSERME del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LUSERME del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplLuserMe (command, &prefix, &nick, &msg, &nclients, &nservers);
       IRCInterface_WriteSystemThread(NULL, msg);
-      syslog(LOG_INFO, "CLIENT:DENTRO comando RPL_LUSERME del server");
+      IRC_Debug("CLIENT:DENTRO comando RPL_LUSERME del server");
       /*Liberacion de punteros*/
       IRC_MFree(3, &prefix, &nick, &msg);
 
       break;
 
     case RPL_MOTDSTART:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_MOTDSTART del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_MOTDSTART del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case RPL_MOTD:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_MOTD del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_MOTD del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplMotd(command, &prefix, &nick, &msg) == IRC_OK){
         IRCInterface_WriteSystemThread(NULL, msg);
@@ -721,18 +721,18 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_ENDOFMOTD:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_ENDOFMOTD del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_ENDOFMOTD del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCInterface_WriteSystemThread(NULL, "End of MOTD command");
       break;
 
     case RPL_WHOREPLY:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOREPLY del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOREPLY del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplWhoReply(command, &prefix, &nick, &channel, &user, &host, &server, &nick2, &type, &msg, &hopcount, &realname) == IRC_OK){
 
         if(type[1] == '@'){
-          syslog(LOG_INFO, "es op");
+          IRC_Debug("es op");
           IRCInterface_AddNickChannelThread(channel, nick2, user, realname, host, OPERATOR);
         }else{
           IRCInterface_AddNickChannelThread(channel, nick2, user, realname, host, NONE);
@@ -743,7 +743,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_CHANNELMODEIS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_CHANNELMODEIS del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_CHANNELMODEIS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplChannelModeIs(command, &prefix, &nick, &channel, &modetxt) == IRC_OK){
         if(prefix == NULL)
@@ -761,16 +761,16 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_CHANOPRIVSNEEDED:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_CHANOPRIVSNEEDED del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_CHANOPRIVSNEEDED del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
 
       switch (IRCParse_ErrChanOPrivsNeeded(command, &prefix, &nick, &channel, &msg)) {
         case IRCERR_NOSTRING:
-          syslog(LOG_INFO, "IRCERR_NOSTRING");
+          IRC_Log(LOG_INFO, "IRCERR_NOSTRING");
           break;
 
         case IRCERR_ERRONEUSCOMMAND:
-          syslog(LOG_INFO, "IRCERR_ERRONEUSCOMMAND");
+          IRC_Log(LOG_INFO, "IRCERR_ERRONEUSCOMMAND");
           break;
 
         default:
@@ -784,7 +784,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_UNKNOWNMODE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_UNKNOWNMODE del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_UNKNOWNMODE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrUnknownMode(command, &prefix, &nick, &mode, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -799,7 +799,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NOSUCHNICK:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NOSUCHNICK del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NOSUCHNICK del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNoSuchNick(command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -813,7 +813,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_CHANNELISFULL:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_CHANNELISFULL del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_CHANNELISFULL del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrChannelIsFull (command, &prefix, &nick, &target, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -827,7 +827,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NICKNAMEINUSE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NICKNAMEINUSE del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NICKNAMEINUSE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNickNameInUse (command, &prefix, &nick, &errnick, &msg);
       sprintf(notificacion, "El nick %s está en uso", errnick);
@@ -842,7 +842,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_ERRONEUSNICKNAME:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_ERRONEUSNICKNAME del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_ERRONEUSNICKNAME del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrErroneusNickName (command, &prefix, &nick, &errnick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -856,7 +856,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NICKCOLLISION:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NICKCOLLISION del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NICKCOLLISION del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNickCollision (command, &prefix, &nick, &name, &msg, &target);
       channel = IRCInterface_ActiveChannelName();
@@ -870,7 +870,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NOMOTD:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NOMOTD del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NOMOTD del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNoMotd (command, &prefix, &nick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -884,7 +884,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NOSUCHCHANNEL:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NOSUCHCHANNEL del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NOSUCHCHANNEL del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNoSuchChannel (command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -899,7 +899,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_PASSWDMISMATCH:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_PASSWDMISMATCH del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_PASSWDMISMATCH del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrPasswdMismatch (command, &prefix, &nick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -913,7 +913,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_INVITEONLYCHAN:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_INVITEONLYCHAN del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_INVITEONLYCHAN del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrInviteOnlyChan (command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -928,7 +928,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_BANNEDFROMCHAN:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_BANNEDFROMCHAN del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_BANNEDFROMCHAN del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrBannedFromChan (command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -943,7 +943,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NONICKNAMEGIVEN:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NONICKNAMEGIVEN del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NONICKNAMEGIVEN del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNoNickNameGiven (command, &prefix, &nick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -957,7 +957,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_RESTRICTED:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_RESTRICTED del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_RESTRICTED del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrRestricted (command, &prefix, &nick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -971,7 +971,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_CANNOTSENDTOCHAN:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_CANNOTSENDTOCHAN del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_CANNOTSENDTOCHAN del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrCanNotSendToChan (command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -986,7 +986,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_NOCHANMODES:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_NOCHANMODES del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_NOCHANMODES del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrNoChanModes (command, &prefix, &nick, &name, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -1001,7 +1001,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_UNAVAILRESOURCE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_UNAVAILRESOURCE del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_UNAVAILRESOURCE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrUnavailResource (command, &prefix, &nick, &target);
       channel = IRCInterface_ActiveChannelName();
@@ -1016,7 +1016,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case ERR_ALREADYREGISTRED:
-      syslog(LOG_INFO, "CLIENT: He recibido comando ERR_ALREADYREGISTRED del server");
+      IRC_Debug("CLIENT: He recibido comando ERR_ALREADYREGISTRED del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_ErrAlreadyRegistred (command, &prefix, &nick, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -1031,7 +1031,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_WHOISUSER:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOISUSER del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOISUSER del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplWhoIsUser(command, &prefix, &nick, &nick2, &name, &host, &realname) == IRC_OK){
         sprintf(notificacion, "[%s] (%s:%s): %s", nick, name, host, realname);
@@ -1047,7 +1047,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_WHOISSERVER:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOISSERVER del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOISSERVER del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplWhoIsServer(command, &prefix, &nick, &nick2, &server, &msg);
       sprintf(notificacion, "[%s] %s %s", nick, server, msg);
@@ -1063,7 +1063,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_WHOISIDLE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOISIDLE del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOISIDLE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplWhoIsIdle(command, &prefix, &nick, &nick2, &secs_idle, &signon, &msg);
       sprintf(notificacion, "[%s] inactivo durante %d seg, entro: %d", nick, secs_idle, signon);
@@ -1078,17 +1078,17 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_ENDOFWHOIS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_ENDOFWHOIS del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_ENDOFWHOIS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case RPL_ENDOFWHO:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_ENDOFWHO del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_ENDOFWHO del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case RPL_YOUREOPER:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_YOUREOPER del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_YOUREOPER del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplYoureOper(command, &prefix, &nick, &msg);
         sprintf(notificacion, "%s", msg);
@@ -1104,7 +1104,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_AWAY:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_AWAY del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_AWAY del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplAway(command, &prefix, &nick, &nick2, &msg) == IRC_OK){
         channel = IRCInterface_ActiveChannelName();
@@ -1121,7 +1121,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_NOWAWAY:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_NOWAWAY del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_NOWAWAY del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       if(IRCParse_RplNowAway(command, &prefix, &nick, &msg) == IRC_OK){
         sprintf(notificacion, "%s", msg);
@@ -1131,7 +1131,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_TOPIC:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_TOPIC del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_TOPIC del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplTopic (command, &prefix, &nick, &name, &topic);
       sprintf(notificacion, "Topic de %s: %s",name, topic);
@@ -1145,7 +1145,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_NOTOPIC:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_NOTOPIC del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_NOTOPIC del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplNoTopic (command, &prefix, &nick, &name, &topic);
       sprintf(notificacion, "El canal %s no tiene Topic establecido", name);
@@ -1159,7 +1159,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_INFO:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_INFO del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_INFO del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplInfo (command, &prefix, &nick, &info);
       sprintf(notificacion, "Info: %s", info);
@@ -1173,7 +1173,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_LIST:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LIST del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LIST del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplList (command, &prefix, &nick, &name, &visible, &topic);
       sprintf(notificacion, "%s \t Tema: %s Usuarios: %s", name, topic, visible);
@@ -1187,7 +1187,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_LISTEND:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LISTEND del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LISTEND del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       channel = IRCInterface_ActiveChannelName();
       if(IRCInterface_QueryChannelExist(channel) == FALSE){
@@ -1198,12 +1198,12 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_ENDOFNAMES:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_ENDOFNAMES del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_ENDOFNAMES del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       break;
 
     case RPL_LUSEROP:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LUSEROP del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LUSEROP del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplLuserOp (command, &prefix, &nick, &nops, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -1217,14 +1217,14 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_MYINFO:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_MYINFO del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_MYINFO del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplMyInfo (command, &prefix, &nick, &servername, &version, &availableusermodes, &availablechannelmodes, &addedg);
       IRC_MFree(7, &prefix, &nick, &servername, &version, &availableusermodes, &availablechannelmodes, &addedg);
       break;
 
     case RPL_WHOISOPERATOR:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOISOPERATOR del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOISOPERATOR del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplWhoIsOperator (command, &prefix, &nick, &nick2, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -1238,7 +1238,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_WHOISCHANNELS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_WHOISCHANNELS del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_WHOISCHANNELS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplWhoIsChannels (command, &prefix, &nick, &nick2, &name);
       channel = IRCInterface_ActiveChannelName();
@@ -1252,14 +1252,14 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_YOURESERVICE:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_YOURESERVICE del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_YOURESERVICE del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplYoureService (command, &prefix, &nick, &msg, &servicename);
       IRC_MFree(4, &prefix, &nick, &msg, &servicename);
       break;
 
     case RPL_LUSERCHANNELS:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_LUSERCHANNELS del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_LUSERCHANNELS del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplLuserChannels (command, &prefix, &nick, &nchannels, &msg);
       channel = IRCInterface_ActiveChannelName();
@@ -1273,7 +1273,7 @@ void IRC_Reply_Parser(char* command, int desc)
       break;
 
     case RPL_NAMREPLY:
-      syslog(LOG_INFO, "CLIENT: He recibido comando RPL_NAMREPLY del server");
+      IRC_Debug("CLIENT: He recibido comando RPL_NAMREPLY del server");
       IRCInterface_PlaneRegisterInMessageThread(command);
       IRCParse_RplNamReply (command, &prefix, &nick, &type, &name, &msg);
       IRC_MFree(5, &prefix, &nick, &type, &name, &msg);
@@ -0,0 +1,320 @@
+/**
+* @brief Registro asincrono de mensajes del cliente
+* @file G-2313-07-P2-log.c
+*
+* @authors Alfonso Bonilla (alfonso.bonilla@estudiante.uam.es)
+* @authors Monica de la Iglesia (monica.delaiglesia@estudiante.uam.es)
+* @version 1.2
+* @date 18-10-2026
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../includes/G-2313-07-P2-log.h"
+
+/*! @page irc_log Registro de mensajes
+*
+* <p>Esta sección incluye el registro de mensajes del cliente. Es una copia de
+* G-2313-07-P1-log.c, porque cada practica se entrega y compila por separado, asi que cualquier
+* arreglo en uno hay que llevarlo tambien al otro.</p>
+*
+* <p>Cada hilo escribe sus lineas ya formateadas en un anillo propio, sin cerrojos: el
+* hilo es el unico que avanza el indice de escritura y el hilo de vaciado el unico que avanza
+* el de lectura. El hilo de vaciado recorre los anillos, envia a syslog todo lo que encuentra
+* de una vez y, si no habia nada, duerme LOG_ESPERA milisegundos. Si un anillo se llena las
+* lineas nuevas se descartan y se cuentan, el cliente nunca espera por el registro.<br>
+* Los anillos de los hilos que terminan, como los de las transferencias de ficheros, se
+* reutilizan para los hilos nuevos.</p>
+*
+* <p>La prioridad maxima se elige al arrancar con -l y se puede cambiar con IRC_Log_Level. Lo
+* que queda por encima se descarta antes de formatearlo. Las trazas de depuracion se escriben
+* con IRC_Debug, que no genera codigo al compilar con NDEBUG.</p>
+*
+* <h2>Cabeceras</h2>
+* <code>
+* \b #include \b <G-2313-07-P2-log.h>
+* </code>
+*
+* <hr>
+* <hr>
+*
+* <h2>Funciones implementadas</h2>
+* <ul>
+* <li>@subpage IRC_Log_Init</li>
+* <li>@subpage IRC_Log_Level</li>
+* <li>@subpage IRC_Log</li>
+* <li>@subpage IRC_Log_Flush</li>
+* </ul>
+*
+* <hr>
+* <hr>
+*
+* <h2>Información</h2>
+* @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+* @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+* @copyright Pareja 7 - Grupo 2313
+*/
+
+static atomic_int nivel_log = LOG_INFO;        /*!<Prioridad maxima que se registra*/
+static atomic_int activo = 0;                  /*!<El hilo de vaciado esta en marcha*/
+static Anillo * _Atomic anillos = NULL;        /*!<Lista de anillos, solo crece*/
+static _Thread_local Anillo *anillo_actual = NULL; /*!<Anillo del hilo en curso*/
+static pthread_key_t clave;                    /*!<Para liberar el anillo cuando termina el hilo*/
+static pthread_mutex_t vaciando = PTHREAD_MUTEX_INITIALIZER; /*!<Un solo hilo vacia a la vez*/
+
+
+/*Deja el anillo del hilo que termina para que lo use otro*/
+static void IRC_Log_Release(void *arg)
+{
+	atomic_store_explicit(&((Anillo *) arg)->libre, 1, memory_order_release);
+}
+
+/*Anillo del hilo en curso, cogiendo uno libre o creando uno la primera vez*/
+static Anillo *IRC_Log_Ring()
+{
+	Anillo *anillo;
+	int libre;
+
+	if(anillo_actual != NULL)
+		return anillo_actual;
+
+	for(anillo = atomic_load(&anillos); anillo != NULL; anillo = anillo->sig){
+		libre = 1;
+		if(atomic_compare_exchange_strong(&anillo->libre, &libre, 0))
+			break;
+	}
+
+	if(anillo == NULL){
+		if((anillo = (Anillo *) malloc(sizeof(Anillo))) == NULL)
+			return NULL;
+		atomic_init(&anillo->escritas, 0);
+		atomic_init(&anillo->leidas, 0);
+		atomic_init(&anillo->perdidas, 0);
+		atomic_init(&anillo->libre, 0);
+		anillo->sig = atomic_load(&anillos);
+		while(!atomic_compare_exchange_weak(&anillos, &anillo->sig, anillo));
+	}
+
+	pthread_setspecific(clave, anillo);
+	anillo_actual = anillo;
+
+	return anillo;
+}
+
+/*Envia a syslog lo pendiente de todos los anillos, devuelve las lineas enviadas*/
+static unsigned long IRC_Log_Drain()
+{
+	Anillo *anillo;
+	Linea *linea;
+	unsigned long leidas, escritas, perdidas, total = 0;
+
+	pthread_mutex_lock(&vaciando);
+	for(anillo = atomic_load(&anillos); anillo != NULL; anillo = anillo->sig){
+		leidas = atomic_load_explicit(&anillo->leidas, memory_order_relaxed);
+		escritas = atomic_load_explicit(&anillo->escritas, memory_order_acquire);
+		total += escritas - leidas;
+
+		for(; leidas != escritas; leidas++){
+			linea = &anillo->lineas[leidas & (LOG_ANILLO-1)];
+			syslog(linea->nivel, "%s", linea->texto);
+		}
+		/*Hasta aqui el hilo no puede reescribir esas lineas*/
+		atomic_store_explicit(&anillo->leidas, leidas, memory_order_release);
+
+		if((perdidas = atomic_exchange_explicit(&anillo->perdidas, 0, memory_order_relaxed)) > 0)
+			syslog(LOG_WARNING, "Log ring full, %lu lines dropped", perdidas);
+	}
+	pthread_mutex_unlock(&vaciando);
+
+	return total;
+}
+
+/*Hilo de vaciado*/
+static void *IRC_Log_Thread(void *arg)
+{
+	struct timespec espera;
+
+	espera.tv_sec = 0;
+	espera.tv_nsec = LOG_ESPERA * 1000000L;
+
+	while(1){
+		if(IRC_Log_Drain() == 0)
+			nanosleep(&espera, NULL);
+	}
+
+	return NULL;
+}
+
+/**
+ * @page IRC_Log_Init IRC_Log_Init
+ * @brief Lanza el hilo que vacia los anillos en syslog
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P2-log.h"
+ *
+ * void IRC_Log_Init(int nivel)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se llama una vez, despues de openlog. Hasta entonces IRC_Log llama directamente a syslog.
+ *
+ * @param[in] nivel prioridad maxima que se registra, por ejemplo LOG_INFO
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Log_Init(int nivel)
+{
+	pthread_t hilo;
+
+	IRC_Log_Level(nivel);
+
+	if(pthread_key_create(&clave, IRC_Log_Release) != 0 || pthread_create(&hilo, NULL, IRC_Log_Thread, NULL) != 0){
+		syslog(LOG_ERR, "Error launching log thread, logging synchronously");
+		return;
+	}
+	pthread_detach(hilo);
+	atomic_store(&activo, 1);
+}
+
+/**
+ * @page IRC_Log_Level IRC_Log_Level
+ * @brief Cambia la prioridad maxima que se registra
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P2-log.h"
+ *
+ * void IRC_Log_Level(int nivel)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Se puede llamar en cualquier momento y desde cualquier hilo. Tambien ajusta la mascara de
+ * syslog.
+ *
+ * @param[in] nivel prioridad de syslog, de LOG_EMERG a LOG_DEBUG
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Log_Level(int nivel)
+{
+	if(nivel < LOG_EMERG)
+		nivel = LOG_EMERG;
+	if(nivel > LOG_DEBUG)
+		nivel = LOG_DEBUG;
+
+	atomic_store_explicit(&nivel_log, nivel, memory_order_relaxed);
+	setlogmask(LOG_UPTO(nivel));
+}
+
+/**
+ * @page IRC_Log IRC_Log
+ * @brief Registra un mensaje sin llamar a syslog desde el hilo que lo genera
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P2-log.h"
+ *
+ * void IRC_Log(int nivel, const char *formato, ...)
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Si la prioridad esta por encima de la elegida no hace nada. Si no, formatea el mensaje en el
+ * anillo del hilo y lo publica para el hilo de vaciado. Con el anillo lleno la linea se descarta
+ * y se avisa del numero de lineas perdidas en la siguiente vuelta del vaciado.
+ *
+ * @param[in] nivel prioridad de syslog
+ * @param[in] formato formato como el de printf, seguido de sus argumentos
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Log(int nivel, const char *formato, ...)
+{
+	va_list args;
+	Anillo *anillo;
+	Linea *linea;
+	unsigned long escritas;
+
+	if(nivel > atomic_load_explicit(&nivel_log, memory_order_relaxed))
+		return;
+
+	va_start(args, formato);
+
+	if(atomic_load_explicit(&activo, memory_order_relaxed) == 0 || (anillo = IRC_Log_Ring()) == NULL){
+		vsyslog(nivel, formato, args);
+		va_end(args);
+		return;
+	}
+
+	escritas = atomic_load_explicit(&anillo->escritas, memory_order_relaxed);
+	if(escritas - atomic_load_explicit(&anillo->leidas, memory_order_acquire) >= LOG_ANILLO){
+		atomic_fetch_add_explicit(&anillo->perdidas, 1, memory_order_relaxed);
+		va_end(args);
+		return;
+	}
+
+	linea = &anillo->lineas[escritas & (LOG_ANILLO-1)];
+	linea->nivel = nivel;
+	vsnprintf(linea->texto, LOG_LINEA, formato, args);
+	va_end(args);
+
+	atomic_store_explicit(&anillo->escritas, escritas + 1, memory_order_release);
+}
+
+/**
+ * @page IRC_Log_Flush IRC_Log_Flush
+ * @brief Envia a syslog todo lo pendiente
+ * <h2>Synopsis</h2>
+ *
+ * @code
+ * #include "includes/G-2313-07-P2-log.h"
+ *
+ * void IRC_Log_Flush()
+ * @endcode
+ *
+ * <h2>Descripción</h2>
+ *
+ * Vacia los anillos desde el hilo que llama, sin esperar al hilo de vaciado. Se usa al terminar
+ * el cliente para no perder las ultimas lineas.
+ *
+ * <hr>
+ *
+ * <h2>Información</h2>
+ * @authors Alfonso Bonilla Trueba (alfonso.bonilla@estudiante.uam.es)
+ * @authors Mónica de la Iglesia Martínez (monica.delaiglesia@estudiante.uam.es)
+ * @copyright Pareja 7 - Grupo 2313
+ *
+ * <hr>
+ *
+ */
+void IRC_Log_Flush()
+{
+	IRC_Log_Drain();
+}